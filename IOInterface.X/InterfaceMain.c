@@ -24,139 +24,307 @@
 #include <stdio.h>
 #include <string.h>
 #include <pic16f1827.h>
-#include "setting.h"            // ݒl
-#include "libcom.h"             // ʒ`
-#include "i2cUtil.h"            // I2C֐Cup
-#include "keypad.h"             // L[pbh
+#include "setting.h"            // 設定値
+#include "libcom.h"             // 共通定義
+#include "i2cUtil.h"            // I2C関数ライブラリ用
+#include "keypad.h"             // キーパッド
 #include "st7032.h"             // LCD
 
 /******************************************************************************/
 /***       Macro Definitions                                                ***/
 /******************************************************************************/
-// RtBOP
-#pragma config FOSC     = INTOSC  // NbN(INTOSC:16MHz)gp
-#pragma config WDTE     = OFF     // EIb`hbO^C}[(OFF)
-#pragma config PWRTE    = ON      // dON64msɃvOJn(ON)
-#pragma config MCLRE    = OFF     // OZbgM͎gpɃfW^(RA3)sƂ(OFF)
-#pragma config CP       = OFF     // vO[ی삵Ȃ(OFF)
-#pragma config CPD      = OFF     // EEPROM̃f[^ǂݏoiOFFj
-#pragma config BOREN    = ON      // dd~(BORVݒȉ)펞Ď@\ON(ON)
-#pragma config CLKOUTEN = OFF     // CLKOUTsRA4sŎgp(OFF)
-#pragma config IESO     = OFF     // ONbNւ̐ؑւł̋N͂Ȃ(OFF)
-#pragma config FCMEN    = OFF     // NbNĎȂ(OFF)
-
-// RtBOQ
-#pragma config WRT      = OFF     // Flash[ی삵Ȃ(OFF)
-#pragma config PLLEN    = OFF     // NbN32MHzł͓삳Ȃ(OFF)
-#pragma config STVREN   = ON      // X^bNI[ot[A_[t[烊Zbg(ON)
-#pragma config BORV     = HI      // dd~펞Ďd(2.7V)ݒ(HI)
-#pragma config LVP      = OFF     // dvO~O@\gpȂ(OFF)
+// コンフィグ１
+#pragma config FOSC     = INTOSC  // 内部クロック(INTOSC:16MHz)使用する
+#pragma config WDTE     = OFF     // ウオッチドッグタイマー無し(OFF)
+#pragma config PWRTE    = ON      // 電源ONから64ms後にプログラムを開始する(ON)
+#pragma config MCLRE    = OFF     // 外部リセット信号は使用せずにデジタル入力(RA3)ピンとする(OFF)
+#pragma config CP       = OFF     // プログラムメモリーを保護しない(OFF)
+#pragma config CPD      = OFF     // EEPROMのデータ読み出し許可（OFF）
+#pragma config BOREN    = ON      // 電源電圧降下(BORV設定以下)常時監視機能ON(ON)
+#pragma config CLKOUTEN = OFF     // CLKOUTピンをRA4ピンで使用する(OFF)
+#pragma config IESO     = OFF     // 内部から外部クロックへの切替えでの起動はなし(OFF)
+#pragma config FCMEN    = OFF     // 部クロック監視しない(OFF)
+
+// コンフィグ２
+#pragma config WRT      = OFF     // Flashメモリーを保護しない(OFF)
+#pragma config PLLEN    = OFF     // 動作クロックを32MHzでは動作させない(OFF)
+#pragma config STVREN   = ON      // スタックがオーバフローやアンダーフローしたらリセットをする(ON)
+#pragma config BORV     = HI      // 電源電圧降下常時監視電圧(2.7V)設定(HI)
+#pragma config LVP      = OFF     // 低電圧プログラミング機能使用しない(OFF)
 
 // I2C 7bit address
 #ifndef I2C_ADDR
 #define	I2C_ADDR            (0x08)
 #endif
 
-// sFd֌W
-#define PIN_POWER           RB0
-#define PIN_BACK_LIGHT      RB3
+// ピン：電源関係（PORTBの読み戻しで通知ピンのLATB6を汚さない様にLATで駆動する）
+#define PIN_POWER           LATB0
+#define PIN_BACK_LIGHT      LATB3
+// ピン：通知（オープンドレイン、TRISで出力Lowとハイインピーダンスを切り替える）
+#ifndef PIN_ATTN_TRIS
+#define PIN_ATTN_TRIS       TRISB6
+#define PIN_ATTN_LAT        LATB6
+#endif
 
-// LCDRgXg
+// LCDコントラスト
 #define LCD_CONTRAST_DEF    (0x28)
+// 描画間隔（タイマーイベント単位、0:即時描画）
+#ifndef LCD_FRAME_DEF
+#define LCD_FRAME_DEF       (0)
+#endif
+
+// キー設定の初期値（1/128秒単位の時間をKEYPAD_u8ScanStepの走査周期に換算）
+// キー値は全行の走査毎に判定する為、KEYPAD_ROW_SIZE/128秒単位となる
+#define KEY_SCAN_CNT(t)     (((t) + KEYPAD_ROW_SIZE - 1) / KEYPAD_ROW_SIZE)
+#ifndef KEY_DEBOUNCE_DEF
+#define KEY_DEBOUNCE_DEF    KEY_SCAN_CNT(6)     // チャタリング判定
+#define KEY_DELAY_DEF       KEY_SCAN_CNT(128)   // 長押し判定
+#define KEY_RATE_DEF        KEY_SCAN_CNT(12)    // 最短リピート間隔
+#define KEY_ACCEL_DEF       KEY_SCAN_CNT(116)   // リピート加速
+#endif
 
-// }bvTCY
-#define MAP_SIZE            (0xA7)
-// }bṽf[^TCY
+// メモリマップサイズ
+#define MAP_SIZE            (0xBA)
+// メモリマップ状のデータサイズ
 #define MAP_DATA_SIZE       (80)
 #define MAP_CGRAM_SIZE      (64)
 #define MAP_ICONRAM_SIZE    (16)
-// }bvʒu
+// メモリマップ位置
 #define	MAP_ADDR_DISPLAY    (0x07)
 #define	MAP_ADDR_CGRAM      (0x57)
 #define	MAP_ADDR_ICONRAM    (0x97)
+#define	MAP_ADDR_DRAWCTRL   (0xA7)
+#define	MAP_ADDR_FRAME      (0xA8)
+#define	MAP_ADDR_ATTN       (0xA9)
+#define	MAP_ADDR_KEYCONF    (0xAB)
+#define	MAP_ADDR_KEYFIFO    (0xAF)
+#define	MAP_ADDR_KEYSTATE   (0xB7)
+// 先読み無し（メモリマップ外のアドレス）
+#define READ_ADDR_NONE      (0xFF)
+
+// メモリマップ領域の数
+#define MAP_REGION_CNT      (23)
+// メモリマップのブロック数（ブロック番号 = (アドレス + 1) / 8）
+#define MAP_BLOCK_CNT       ((MAP_SIZE + 8) / 8)
+// ブロック内のアドレス毎に領域が異なる（レジスタのブロック）
+#define MAP_BLOCK_REG       (0x80)
+// メモリマップ領域の属性
+#define MAP_FLG_READONLY    (0x01)  // 書き込みを無視する
+#define MAP_FLG_VOLATILE    (0x02)  // 割り込みで変化する（先読みしない）
+#define MAP_FLG_ATTN        (0x04)  // 書き込み後に通知ピンを更新する
+#define MAP_FLG_POWER       (0x08)  // 電源オフ時にメモリマップを初期化する
+#define MAP_FLG_ICON        (0x10)  // 更新アイコンを記録する
+#define MAP_FLG_CGRAM       (0x20)  // 更新ユーザー文字を記録する
+#define MAP_FLG_HOLD        (0x40)  // 保持モード中は描画を確定まで保留する
+#define MAP_FLG_DRAW_CTRL   (0x80)  // 描画制御（描画の保留と確定）
+
+// メモリマップ領域の読み込み時の副作用
+#define MAP_READ_NONE       (0x00)  // 副作用無し
+#define MAP_READ_CLEAR      (0x01)  // 読み込み後に0xFFへクリアする
+#define MAP_READ_KEY_FIFO   (0x02)  // 読み込み済みのキーイベントを取り出す
+#define MAP_READ_ATTN       (0x03)  // 通知要因をクリアして通知ピンを開放する
+#define MAP_READ_KEY_STATE  (0x04)  // キー状態の上位バイトを保持する
+
+// 描画制御レジスタ
+#define DRAW_CTRL_HOLD      (0x01)  // 保持モード（確定までRAMの描画を保留）
+#define DRAW_CTRL_COMMIT    (0x02)  // 確定要求（書き込み専用）
+
+// 通知要因
+#define ATTN_CAUSE_KEY      (0x01)  // キーイベントの追加
+#define ATTN_CAUSE_FRAME    (0x02)  // 確定した描画の完了
+// 通知要因マスクの初期値
+#ifndef ATTN_MASK_DEF
+#define ATTN_MASK_DEF       (ATTN_CAUSE_KEY | ATTN_CAUSE_FRAME)
+#endif
+
+// 受信バッファのレコード数（2のべき乗）
+// 表示文字/ユーザー文字/アイコンRAMと描画制御への書き込みは割り込みで直接
+// 反映する為、受信バッファには制御レジスタへの書き込みのみ格納する。
+// 受信バッファが一杯の場合は、主処理が空きを作るまでSCLラインを保持して
+// ホストを待たせる（NACKしない）。
+#ifndef RX_BUFF_SIZE
+#define RX_BUFF_SIZE        (4)
+#endif
+#define RX_BUFF_MASK        (RX_BUFF_SIZE - 1)
+// 受信レコードの属性
+#define RX_FLG_SYNC         (0x01)  // 反映するまで割り込みでの直接反映を止める
+
+// キーイベントFIFOの件数（領域の終端をブロック境界に合わせる為に固定）
+#define KEY_FIFO_SIZE       (3)
+// キーイベント１件のサイズ（イベント種別とキー番号、タイムスタンプ）
+#define KEY_EVT_SIZE        (2)
+#define KEY_EVT_TYPE_SHIFT  (4)     // イベント種別は上位4bit、キー番号は下位4bit
+// キーイベントFIFO領域のサイズ（件数、キーイベント×KEY_FIFO_SIZE、予約）
+#define KEY_FIFO_LEN        (1 + KEY_FIFO_SIZE * KEY_EVT_SIZE + 1)
+// キーイベント件数レジスタ
+#define KEY_FIFO_CNT_MASK   (0x7F)  // 件数
+#define KEY_FIFO_OVERFLOW   (0x80)  // 溢れたイベント有り（取り出し時にクリア）
+// キー走査フラグ
+#define KEY_FLG_GHOST       (0x01)  // ゴースト検出中（キー状態は更新されない）
 
 /******************************************************************************/
 /***        Type Definitions                                                ***/
 /******************************************************************************/
 /**
- * Xe[^X
+ * ステータス
  */
 typedef enum {
-    MEM_STS_NORMAL      = 0x00, // 
-    MEM_STS_PROCESSING  = 0x01  // 
+    MEM_STS_NORMAL      = 0x00, // 正常
+    MEM_STS_PROCESSING  = 0x01  // 処理中
 } teMapStatus;
 
 /**
- * Cxg
+ * イベント種別
  */
 typedef enum {
-    EVT_NONE            = 0x00, // ʒmCxg
-    EVT_TIMER           = 0x01, // ^C}[
-    EVT_PW_CONTRAST     = 0x02, // dARgXgݒ
-    EVT_CURSOR_SET      = 0x04, // J[\ݒ
-    EVT_CURSOR_DRAW     = 0x08, // J[\`
-    EVT_DRAW_LINE_0     = 0x10, // Psڕ`
-    EVT_DRAW_LINE_1     = 0x20, // Qsڕ`
-    EVT_SET_CGRAM       = 0x40, // CGRAMݒ
-    EVT_DRAW_ICON       = 0x80  // ACR`
+    EVT_NONE            = 0x00, // 通知イベント無し
+    EVT_TIMER           = 0x01, // タイマー
+    EVT_PW_CONTRAST     = 0x02, // 電源、コントラスト設定
+    EVT_CURSOR_SET      = 0x04, // カーソル設定
+    EVT_CURSOR_DRAW     = 0x08, // カーソル描画
+    EVT_DRAW_LINE_0     = 0x10, // １行目描画
+    EVT_DRAW_LINE_1     = 0x20, // ２行目描画
+    EVT_SET_CGRAM       = 0x40, // CGRAM設定
+    EVT_DRAW_ICON       = 0x80  // アイコン描画
 } teEventType;
 
+// 描画間隔で間引くイベント
+#define EVT_FRAME_MASK      (EVT_DRAW_LINE_0 | EVT_DRAW_LINE_1 | EVT_SET_CGRAM | EVT_DRAW_ICON)
+
 /**
- * AvP[VXe[^X
+ * アプリケーションステータス
  */
 typedef struct {
-    uint8 u8TimerCnt;           // ^C}[JE^
-    bool bWriteStartFlg;        // ݃X^[gRfBVMtO
-    uint8 u8MapAddr;            // ݃}bvAhXʒu
-    uint8 u8EventMap;           // Cxg}bv
+    uint8 u8TimerCnt;           // タイマーカウンタ
+    bool bWriteStartFlg;        // 書き込みスタートコンディション受信フラグ
+    uint8 u8MapAddr;            // 現在メモリマップアドレス位置
+    uint8 u8ReadAddr;           // 先読みデータのメモリマップアドレス
+    uint8 u8ReadData;           // 先読みデータ
+    bool bPrefetchReq;          // 先読み要求フラグ（SCLライン開放後に先読みする）
+    uint8 u8WriteEnd;           // 書き込み中の領域の終端アドレス（次の領域の先頭）
+    uint8 u8WriteMax;           // 書き込み中の領域の書き込み値の上限
+    uint8 u8WriteFlg;           // 書き込み中の領域の属性（MAP_FLG_*）
+    uint8 u8DirectAddr;         // 直接反映するメモリマップアドレス（READ_ADDR_NONE:無し）
+    uint8 u8DirectData;         // 直接反映する書き込みデータ
+    uint8 u8DirectEvent;        // 直接反映したトランザクション終了待ちのイベントマップ
+    uint8 u8EventMap;           // イベントマップ
+    uint16 u16IconMask;         // 更新アイコンのビットマップ
+    uint8 u8CGRamMask;          // 更新ユーザー文字のビットマップ
+    uint8 u8PendEvent;          // トランザクション終了待ちのイベントマップ
+    uint8 u8HoldEvent;          // 確定待ちの描画イベントマップ（保持モード）
+    uint8 u8FrameCnt;           // 前回の描画からのタイマーイベント数
+    uint8 u8FrameEvent;         // 描画間隔の経過待ちの描画イベントマップ
+    uint8 u8Tick;               // タイムスタンプ（1/128秒単位のフリーランカウンタ）
+    uint8 u8KeyPopCnt;          // 読み込み済みのキーイベント件数
+    uint8 u8KeyFifoNext;        // 今回の読み込みで先頭から連続して送信したFIFOの次の位置
+    uint8 u8KeyFifoCnt;         // 今回の読み込みで送信したキーイベント件数レジスタの値
+    uint8 u8KeyStateHi;         // キー状態の上位バイト（下位バイトの読み込みで保持）
+    bool bRxHold;               // 受信保留フラグ（受信バッファ満杯でSCLライン保持中）
+    uint8 u8HoldAddr;           // 受信保留中のメモリマップアドレス
+    uint8 u8HoldData;           // 受信保留中の書き込みデータ
+    uint8 u8HoldFlags;          // 受信保留中のレコードの属性（RX_FLG_*）
+    bool bFrameCommit;          // 確定した描画の描画待ちフラグ（描画制御で確定済み）
+    bool bFramePend;            // 描画完了の通知待ちフラグ（LCDへの非同期送信中）
 } tsAppStatus;
 
 /**
- * }bv
+ * メモリマップ
  */
 typedef struct {
-    teMapStatus eStatus;                    // Xe[^X
-    uint8 u8KeyValue;                       // L[liŏIlj
-    uint8 u8Power;                          // obNCg
-    uint8 u8Contrast;                       // RgXg
-    uint8 u8CursorType;                     // J[\^Cv
-    uint8 u8CursorRow;                      // J[\s
-    uint8 u8CursorCol;                      // J[\
-    uint8 u8DispRam[MAP_DATA_SIZE];         // \RAM
-    uint8 u8CGRam[MAP_CGRAM_SIZE];          // [U[RAM
-    uint8 u8IconRam[MAP_ICONRAM_SIZE];      // ACRRAM
+    teMapStatus eStatus;                    // ステータス
+    uint8 u8KeyValue;                       // キー値（最終値）
+    uint8 u8Power;                          // バックライト
+    uint8 u8Contrast;                       // コントラスト
+    uint8 u8CursorType;                     // カーソルタイプ
+    uint8 u8CursorRow;                      // カーソル行
+    uint8 u8CursorCol;                      // カーソル列
+    uint8 u8DispRam[MAP_DATA_SIZE];         // 表示文字RAM
+    uint8 u8CGRam[MAP_CGRAM_SIZE];          // ユーザー文字RAM
+    uint8 u8IconRam[MAP_ICONRAM_SIZE];      // アイコンRAM
+    uint8 u8DrawCtrl;                       // 描画制御
+    uint8 u8FrameInterval;                  // 描画間隔（1/64秒単位、0:即時）
+    uint8 u8AttnCause;                      // 通知要因（読み込みでクリア）
+    uint8 u8AttnMask;                       // 通知要因マスク（1:通知ピンを駆動）
+    uint8 u8KeyEvtCnt;                      // キーイベント件数
+    uint8 u8KeyEvent[KEY_FIFO_LEN - 1];     // キーイベントFIFO（末尾は予約で常に0）
+    uint8 u8KeyState[2];                    // キー状態（下位、上位）
+    uint8 u8KeyFlags;                       // キー走査フラグ
 } tsMemoryMap;
 
+/**
+ * メモリマップ領域の記述子
+ */
+typedef struct {
+    uint8 u8Base;               // 先頭アドレス
+    uint8 u8Len;                // 領域の長さ
+    uint8 *pu8Data;             // メモリマップ上の格納先
+    uint8 u8Max;                // 書き込み値の上限
+    uint8 u8Event;              // 書き込み時に通知するイベント
+    uint8 u8Flags;              // 属性（MAP_FLG_*）
+    uint8 u8ReadFx;             // 読み込み時の副作用（MAP_READ_*）
+} tsMapRegion;
+
+/**
+ * 受信レコード（割り込みから主処理へ渡す書き込みデータ）
+ */
+typedef struct {
+    uint8 u8Addr;               // メモリマップアドレス
+    uint8 u8Data;               // 書き込みデータ
+    uint8 u8Flags;              // 属性（RX_FLG_*）
+} tsRxRecord;
+
 
 /******************************************************************************/
 /***        Local Function Prototypes                                       ***/
 /******************************************************************************/
-// CxgXe[^Xݒ
+// イベントステータス設定
 static void evt_vSetEventMap(teEventType eEvtStatus);
-// CxgXe[^Xݒ
-static void evt_vSetDrawEvent(uint8 u8Addr);
-// Cxg擾
+// イベント情報取得
 static uint8 evt_u8GetEventMap();
-// dݒ菈
+// 電源設定処理
 static void lcd_vPowerSetting(uint8 u8Settings);
-// J[\ݒ`揈
+// カーソル設定描画処理
 static void lcd_vCursorSetting(uint8 u8CursorType);
-// J[\`揈
+// カーソル描画処理
 static void lcd_vDrawCursor();
-// s`揈
+// 描画イベントの間引き処理
+static uint8 lcd_u8FrameEvent(uint8 u8EventMap);
+// 行描画処理
 static void lcd_vDarwLine(uint8 u8RowNo);
-// CGRAM
+// CGRAM書き込み
 static void lcd_vDrawCGRAM();
-// ICON Ram
+// ICON Ram書き込み
 static void lcd_vDrawIconRAM();
-// ^C}[荞ݏ
+// タイマー割り込み処理
 static void timer_vInterrupt();
-// I2C荞݂̃R[obN֐
-static void ssp1_vCallback(uint8 u8BusNo, uint8 u8EvtType);
-// ݃NGXg
-static void ssp1_vWriteData(uint8 u8Data);
-// ǂݍ݃NGXg
+// I2C割り込みのコールバック関数
+static bool ssp1_bCallback(uint8 u8BusNo, uint8 u8EvtType);
+// メモリマップ領域の取得
+static const tsMapRegion* map_psGetRegion(uint8 u8Addr);
+// 書き込みデータ受信処理
+static bool ssp1_bReceiveData(uint8 u8Data);
+// 受信データの直接反映処理
+static void ssp1_vWriteDirect();
+// 受信バッファ処理
+static void ssp1_vProcRxBuff();
+// 受信保留レコードの格納とSCLラインの開放
+static void ssp1_vReleaseHold();
+// 書き込みリクエスト処理
+static uint8 ssp1_u8WriteData(uint8 u8MapAddr, uint8 u8Data);
+// 読み込みリクエスト処理
 static uint8 ssp1_u8ReadData();
+// 読み込みデータの先読み処理
+static void ssp1_vPrefetch();
+// 通知要因の追加
+static void attn_vSetCause(uint8 u8Cause);
+// 通知ピンの更新
+static void attn_vUpdate();
+// キーイベントの配信
+static void key_vDispatchEvent(uint8 u8KeyNo, uint8 u8Type);
+// キーイベントの追加
+static void key_vPushEvent(uint8 u8KeyNo, uint8 u8Type);
+// 読み込み済みキーイベントの取り出し
+static void key_vPopEvent();
 
 /******************************************************************************/
 /***        Exported Variables                                              ***/
@@ -168,12 +336,109 @@ static uint8 ssp1_u8ReadData();
 //==============================================================================
 // Variable definition
 //==============================================================================
-// fobOpXe[^X
+// デバッグ用ステータス
 static uint8 u8Status = 0x00;
-// AvP[VXe[^X
+// アプリケーションステータス
 static tsAppStatus sAppStatus;
-// [}bv
+// メモリーマップ
 static tsMemoryMap sMemoryMap;
+// LCDハンドル
+static tsST7032_handle sLcd;
+// キーパッドステータス（キー設定はメモリマップから直接参照）
+static tsKEYPAD_status sKeypad;
+// 受信バッファ（書き込みは割り込み、読み出しは主処理のみ）
+static tsRxRecord sRxBuff[RX_BUFF_SIZE];
+// 受信バッファの書き込み位置（割り込みのみ更新）
+static volatile uint8 u8RxHead = 0;
+// 受信バッファの読み出し位置（主処理のみ更新）
+static volatile uint8 u8RxTail = 0;
+// 受信バッファの確定位置（ストップコンディション検出時の書き込み位置）
+static volatile uint8 u8RxCommit = 0;
+// 未反映の同期レコード数（割り込みで加算、主処理で減算）
+static volatile uint8 u8RxSyncCnt = 0;
+// メモリマップ領域の記述子（制御レジスタはアドレスと同じ番号）
+static const tsMapRegion sMapRegion[MAP_REGION_CNT] = {
+    // 0x00:ステータス（読み込み専用）
+    {0x00, 1, (uint8*)&sMemoryMap.eStatus, 0xFF, EVT_NONE,
+        MAP_FLG_READONLY | MAP_FLG_VOLATILE, MAP_READ_NONE},
+    // 0x01:キー値（最終値モード）
+    {0x01, 1, &sMemoryMap.u8KeyValue, 0xFF, EVT_NONE,
+        MAP_FLG_VOLATILE, MAP_READ_CLEAR},
+    // 0x02:電源設定
+    {0x02, 1, &sMemoryMap.u8Power, 0x03, EVT_PW_CONTRAST, MAP_FLG_POWER,
+        MAP_READ_NONE},
+    // 0x03:コントラスト
+    {0x03, 1, &sMemoryMap.u8Contrast, ST7032_CONTRAST_MAX, EVT_PW_CONTRAST, 0x00,
+        MAP_READ_NONE},
+    // 0x04:カーソルタイプ
+    {0x04, 1, &sMemoryMap.u8CursorType, 0x03, EVT_CURSOR_SET, 0x00,
+        MAP_READ_NONE},
+    // 0x05:カーソル行
+    {0x05, 1, &sMemoryMap.u8CursorRow, ST7032_ROW_MAX, EVT_CURSOR_DRAW, 0x00,
+        MAP_READ_NONE},
+    // 0x06:カーソル列
+    {0x06, 1, &sMemoryMap.u8CursorCol, ST7032_COL_MAX, EVT_CURSOR_DRAW, 0x00,
+        MAP_READ_NONE},
+    // 0x07-0x2E:表示文字RAM（１行目）
+    {MAP_ADDR_DISPLAY, 40, &sMemoryMap.u8DispRam[0], 0xFF, EVT_DRAW_LINE_0,
+        MAP_FLG_HOLD, MAP_READ_NONE},
+    // 0x2F-0x56:表示文字RAM（２行目）
+    {MAP_ADDR_DISPLAY + 40, 40, &sMemoryMap.u8DispRam[40], 0xFF, EVT_DRAW_LINE_1,
+        MAP_FLG_HOLD, MAP_READ_NONE},
+    // 0x57-0x96:ユーザー文字RAM
+    {MAP_ADDR_CGRAM, MAP_CGRAM_SIZE, sMemoryMap.u8CGRam, 0x1F, EVT_SET_CGRAM,
+        MAP_FLG_CGRAM | MAP_FLG_HOLD, MAP_READ_NONE},
+    // 0x97-0xA6:アイコンRAM
+    {MAP_ADDR_ICONRAM, MAP_ICONRAM_SIZE, sMemoryMap.u8IconRam, 0x1F, EVT_DRAW_ICON,
+        MAP_FLG_ICON | MAP_FLG_HOLD, MAP_READ_NONE},
+    // 0xA7:描画制御
+    {MAP_ADDR_DRAWCTRL, 1, &sMemoryMap.u8DrawCtrl, DRAW_CTRL_HOLD | DRAW_CTRL_COMMIT,
+        EVT_NONE, MAP_FLG_DRAW_CTRL, MAP_READ_NONE},
+    // 0xA8:描画間隔
+    {MAP_ADDR_FRAME, 1, &sMemoryMap.u8FrameInterval, 0xFF, EVT_NONE, 0x00,
+        MAP_READ_NONE},
+    // 0xA9:通知要因（読み込みでクリア）
+    {MAP_ADDR_ATTN, 1, &sMemoryMap.u8AttnCause, 0xFF, EVT_NONE,
+        MAP_FLG_READONLY | MAP_FLG_VOLATILE, MAP_READ_ATTN},
+    // 0xAA:通知要因マスク
+    {MAP_ADDR_ATTN + 1, 1, &sMemoryMap.u8AttnMask, ATTN_CAUSE_KEY | ATTN_CAUSE_FRAME,
+        EVT_NONE, MAP_FLG_ATTN, MAP_READ_NONE},
+    // 0xAB:キーのチャタリング判定時間（走査周期単位、KEYPAD_DEBOUNCE_MAXまで）
+    {MAP_ADDR_KEYCONF + 0, 1, &sKeypad.u8Debounce, KEYPAD_DEBOUNCE_MAX, EVT_NONE, 0x00,
+        MAP_READ_NONE},
+    // 0xAC:キーの長押し判定時間（走査周期単位、最初のリピートまでの時間）
+    {MAP_ADDR_KEYCONF + 1, 1, &sKeypad.u8RepeatDelay, 0xFF, EVT_NONE, 0x00,
+        MAP_READ_NONE},
+    // 0xAD:キーの最短リピート間隔（走査周期単位）
+    {MAP_ADDR_KEYCONF + 2, 1, &sKeypad.u8RepeatRate, 0xFF, EVT_NONE, 0x00,
+        MAP_READ_NONE},
+    // 0xAE:キーのリピート加速（リピート毎に間隔を短縮する走査周期数）
+    {MAP_ADDR_KEYCONF + 3, 1, &sKeypad.u8RepeatAccel, 0xFF, EVT_NONE, 0x00,
+        MAP_READ_NONE},
+    // 0xAF-0xB6:キーイベントFIFO（件数、キーイベント×KEY_FIFO_SIZE、予約）
+    {MAP_ADDR_KEYFIFO, KEY_FIFO_LEN, &sMemoryMap.u8KeyEvtCnt,
+        0xFF, EVT_NONE, MAP_FLG_READONLY | MAP_FLG_VOLATILE, MAP_READ_KEY_FIFO},
+    // 0xB7:キー状態（下位バイト、読み込み時に上位バイトを保持）
+    {MAP_ADDR_KEYSTATE, 1, &sMemoryMap.u8KeyState[0], 0xFF, EVT_NONE,
+        MAP_FLG_READONLY | MAP_FLG_VOLATILE, MAP_READ_KEY_STATE},
+    // 0xB8:キー状態（上位バイト、下位バイトの読み込み時点の値）
+    {MAP_ADDR_KEYSTATE + 1, 1, &sMemoryMap.u8KeyState[1], 0xFF, EVT_NONE,
+        MAP_FLG_READONLY, MAP_READ_NONE},
+    // 0xB9:キー走査フラグ
+    {MAP_ADDR_KEYSTATE + 2, 1, &sMemoryMap.u8KeyFlags, 0xFF, EVT_NONE,
+        MAP_FLG_READONLY | MAP_FLG_VOLATILE, MAP_READ_NONE}
+};
+// ブロック毎の領域番号（ブロック0は制御レジスタなのでアドレスを領域番号とする）
+static const uint8 u8MapBlock[MAP_BLOCK_CNT] = {
+    0,                      // 0x00-0x06:制御レジスタ
+    7, 7, 7, 7, 7,          // 0x07-0x2E:表示文字RAM（１行目）
+    8, 8, 8, 8, 8,          // 0x2F-0x56:表示文字RAM（２行目）
+    9, 9, 9, 9, 9, 9, 9, 9, // 0x57-0x96:ユーザー文字RAM
+    10, 10,                 // 0x97-0xA6:アイコンRAM
+    MAP_BLOCK_REG | 11,     // 0xA7-0xAE:描画制御、描画間隔、通知、キー設定
+    19,                     // 0xAF-0xB6:キーイベントFIFO
+    MAP_BLOCK_REG | 20      // 0xB7-0xB9:キー状態、キー走査フラグ
+};
 
 /******************************************************************************/
 /***        Main Functions                                                  ***/
@@ -183,7 +448,7 @@ static tsMemoryMap sMemoryMap;
  *
  * NAME: main
  *
- * DESCRIPTION:又
+ * DESCRIPTION:主処理
  *
  * PARAMETERS:      Name            RW  Usage
  *
@@ -194,134 +459,193 @@ static tsMemoryMap sMemoryMap;
  ******************************************************************************/
 void main() {
     //==========================================================================
-    // ^C}[уsݒ
+    // タイマーおよびピン設定
     //==========================================================================
-    OSCCON = 0b01111010;    // NbN16lgƂ
-    ANSELA = 0b00000000;    // AiOgpȂ(ׂăfW^I/OɊĂ)
-    ANSELB = 0b00000000;    // AiOgpȂ(ׂăfW^I/OɊĂ)
-    TRISA  = 0b00011100;    // L[pbĥݓ̓[hƂ
-    TRISB  = 0b10110110;    // sSDA/SCL̂ݓ
-    PORTA  = 0b00000000;    // o̓s̏(SLOWɂ)
-    PORTB  = 0b00000000;    // o̓s̏(SLOWɂ)
+    OSCCON = 0b01111010;    // 内部クロックは16ＭＨｚとする
+    ANSELA = 0b00000000;    // アナログ使用しない(すべてデジタルI/Oに割当てる)
+    ANSELB = 0b00000000;    // アナログ使用しない(すべてデジタルI/Oに割当てる)
+    TRISA  = 0b00011100;    // キーパッドのみ入力モードとする
+    TRISB  = 0b10110110;    // ピンはSDA/SCLのみ入力
+    PORTA  = 0b00000000;    // 出力ピンの初期化(全てLOWにする)
+    PORTB  = 0b00000000;    // 出力ピンの初期化(全てLOWにする)
 
     //==========================================================================
-    // AvP[VXe[^X̏
+    // アプリケーションステータスの初期化
     //==========================================================================
-    sAppStatus.u8TimerCnt     = 0;          // ^C}[JE^
-    sAppStatus.bWriteStartFlg = false;      // X^[gRfBVMtO
-    sAppStatus.u8MapAddr      = 0x00;       // }bṽAhX
-    sAppStatus.u8EventMap     = 0x00;       // Cxg}bv
+    sAppStatus.u8TimerCnt     = 0;          // タイマーカウンタ
+    sAppStatus.bWriteStartFlg = false;      // スタートコンディション受信フラグ
+    sAppStatus.u8MapAddr      = 0x00;       // マップ上のアドレス
+    sAppStatus.u8ReadAddr     = READ_ADDR_NONE; // 先読みデータのアドレス
+    sAppStatus.u8ReadData     = 0x00;       // 先読みデータ
+    sAppStatus.bPrefetchReq   = false;      // 先読み要求フラグ
+    sAppStatus.u8WriteEnd     = 0x00;       // 書き込み中の領域の終端アドレス
+    sAppStatus.u8WriteMax     = 0x00;       // 書き込み中の領域の上限
+    sAppStatus.u8WriteFlg     = 0x00;       // 書き込み中の領域の属性
+    sAppStatus.u8DirectAddr   = READ_ADDR_NONE; // 直接反映するアドレス
+    sAppStatus.u8DirectData   = 0x00;       // 直接反映するデータ
+    sAppStatus.u8DirectEvent  = 0x00;       // 直接反映した終了待ちのイベントマップ
+    sAppStatus.u8EventMap     = 0x00;       // イベントマップ
+    sAppStatus.u16IconMask    = 0x0000;     // 更新アイコンのビットマップ
+    sAppStatus.u8CGRamMask    = 0x00;       // 更新ユーザー文字のビットマップ
+    sAppStatus.u8PendEvent    = 0x00;       // 終了待ちのイベントマップ
+    sAppStatus.u8HoldEvent    = 0x00;       // 確定待ちの描画イベントマップ
+    sAppStatus.u8FrameCnt     = 0;          // 前回の描画からのタイマーイベント数
+    sAppStatus.u8FrameEvent   = 0x00;       // 描画間隔の経過待ちのイベントマップ
+    sAppStatus.u8Tick         = 0;          // タイムスタンプ
+    sAppStatus.u8KeyPopCnt    = 0;          // 読み込み済みのキーイベント件数
+    sAppStatus.u8KeyFifoNext  = 0;          // 先頭から連続して送信したFIFOの次の位置
+    sAppStatus.u8KeyFifoCnt   = 0;          // 送信したキーイベント件数レジスタの値
+    sAppStatus.u8KeyStateHi   = 0x00;       // キー状態の上位バイト
+    sAppStatus.bRxHold        = false;      // 受信保留フラグ
+    sAppStatus.bFrameCommit   = false;      // 確定した描画の描画待ちフラグ
+    sAppStatus.bFramePend     = false;      // 描画完了の通知待ちフラグ
     
     //==========================================================================
-    // ^C}[ݒ
+    // タイマー設定
     // FOSC = 16MHz / 4
-    // JEgAbvTCN = FOSC / vXP[ = (16MHz / 4) / 128
-    // 1bԂ̊荞݉ = JEgAbvTCN / 256 = 128
+    // カウントアップサイクル = FOSC / プリスケーラ = (16MHz / 4) / 128
+    // 1秒間の割り込み回数 = カウントアップサイクル / 256 = 128回
     //==========================================================================
-    OPTION_REG = 0b00000110;    // NbNTIMER0gpAvXP[ 1:128
-    TMR0   = 0;                 // ^C}[0̏
-    TMR0IF = 0;                 // ^C}[0tO(T0IF)0ɂ
-    TMR0IE = 1;                 // ^C}[0(T0IE)
+    OPTION_REG = 0b00000110;    // 内部クロックでTIMER0を使用、プリスケーラ 1:128
+    TMR0   = 0;                 // タイマー0の初期化
+    TMR0IF = 0;                 // タイマー0割込フラグ(T0IF)を0にする
+    TMR0IE = 1;                 // タイマー0割込み(T0IE)を許可する
     
     //==========================================================================
-    // }bv֘Ȁ
+    // メモリマップ関連の初期化
     //==========================================================================
-    // }bv[NA
+    // メモリマップをゼロクリア
     memset(&sMemoryMap, 0x00, sizeof(tsMemoryMap));
-    sMemoryMap.u8KeyValue = 0xFF;               // L[l
-    sMemoryMap.u8Power    = 0x01;               // LCDd
-    sMemoryMap.u8Contrast = LCD_CONTRAST_DEF;   // LCDRgXg
+    sMemoryMap.u8KeyValue = 0xFF;               // キー値
+    sMemoryMap.u8Power    = 0x01;               // LCD電源
+    sMemoryMap.u8Contrast = LCD_CONTRAST_DEF;   // LCDコントラスト
     memset(sMemoryMap.u8CGRam, 0xE0, MAP_CGRAM_SIZE);   // CGRAM
+    sMemoryMap.u8FrameInterval = LCD_FRAME_DEF; // 描画間隔
+    sMemoryMap.u8AttnMask = ATTN_MASK_DEF;      // 通知要因マスク
+    // 通知ピンは開放（ハイインピーダンス）状態とする
+    PIN_ATTN_LAT  = 0;
+    PIN_ATTN_TRIS = 1;
         
     //==========================================================================
-    // I2C
+    // I2C初期処理
     //==========================================================================
-    // SSP1:X[u[hł̏
-    I2C_vInitSlaveSSP1(I2C_ADDR, I2C_SLAVE_STD, ssp1_vCallback);
-    // SSP2:}X^[[hŏ
-    I2C_vInitMasterSSP2(I2C_MASTER_STD, I2C_CLK_DIV_STD_8MHZ);
+    // SSP1:スレーブモードでの初期化
+    I2C_vInitSlaveSSP1(I2C_ADDR, I2C_SLAVE_STD, ssp1_bCallback);
+    // SSP2:マスターモードで初期化
+    I2C_vInitMasterSSP2(I2C_MASTER_STD, I2C_CLK_DIV(I2C_BAUD_STD));
     
     //==========================================================================
-    // L[pbhݒ
-    //==========================================================================
-    tsKEYPAD_status keypadSts;
-    // ẽs
-    keypadSts.u16PinCols[0] = ID_PORTA | 0b00000100;
-    keypadSts.u16PinCols[1] = ID_PORTA | 0b00001000;
-    keypadSts.u16PinCols[2] = ID_PORTA | 0b00010000;
-    keypadSts.u16PinCols[3] = ID_PORTB | 0b10000000;
-    // es̃s
-    keypadSts.u16PinRows[0] = ID_PORTA | 0b00000010;
-    keypadSts.u16PinRows[1] = ID_PORTA | 0b00000001;
-    keypadSts.u16PinRows[2] = ID_PORTA | 0b10000000;
-    keypadSts.u16PinRows[3] = ID_PORTA | 0b01000000;
+    // キーパッド設定
+    //==========================================================================
+    // 各列のピン
+    sKeypad.u16PinCols[0] = ID_PORTA | 0b00000100;
+    sKeypad.u16PinCols[1] = ID_PORTA | 0b00001000;
+    sKeypad.u16PinCols[2] = ID_PORTA | 0b00010000;
+    sKeypad.u16PinCols[3] = ID_PORTB | 0b10000000;
+    // 各行のピン
+    sKeypad.u16PinRows[0] = ID_PORTA | 0b00000010;
+    sKeypad.u16PinRows[1] = ID_PORTA | 0b00000001;
+    sKeypad.u16PinRows[2] = ID_PORTA | 0b10000000;
+    sKeypad.u16PinRows[3] = ID_PORTA | 0b01000000;
     
-    // Ώۂ̃L[pbh
-    KEYPAD_vInit(&keypadSts);
+    // 対象のキーパッドを初期化する
+    KEYPAD_vInit(&sKeypad);
+    // キー設定を走査周期単位の初期値に変更
+    sKeypad.u8Debounce    = KEY_DEBOUNCE_DEF;
+    sKeypad.u8RepeatDelay = KEY_DELAY_DEF;
+    sKeypad.u8RepeatRate  = KEY_RATE_DEF;
+    sKeypad.u8RepeatAccel = KEY_ACCEL_DEF;
+    // キーイベントの通知先を登録
+    KEYPAD_vSetCallback(key_vDispatchEvent);
     
     //==========================================================================
-    // 荞݂̗L
+    // 割り込みの有効化
     //==========================================================================
-    PEIE = 1;   // ӑu荞ݗL
-    GIE  = 1;   // Sݏ
+    PEIE = 1;   // 周辺装置割り込み有効
+    GIE  = 1;   // 全割込み処理を許可する
 
     //==========================================================================
-    // LCD̏
+    // LCDの初期化処理
     //==========================================================================
-    // LCDsݒ菉
+    // LCDピン設定初期化
     PIN_POWER      = ON;
     PIN_BACK_LIGHT = OFF;
     __delay_ms(40);
-    // LCD
-    ST7032_vInitSSP2();
+    // LCD初期化処理
+    ST7032_vInit(&sLcd, I2C_BUS_SSP2, ST7032_I2C_ADDR);
     
     //==========================================================================
-    // 又[v
+    // 主処理ループ
     //==========================================================================
     uint8 u8EventMap;
-    // C[v
+    // メインループ
     while(true) {
         //----------------------------------------------------------------------
-        // Cxg
+        // イベント処理
         //----------------------------------------------------------------------
-        // Cxgʒm
+        // 受信済みの書き込みデータをメモリマップへ反映
+        ssp1_vProcRxBuff();
+        // 確定した描画のLCDへの送信完了を通知
+        if (sAppStatus.bFramePend && !ST7032_bFlushBusy(&sLcd)) {
+            sAppStatus.bFramePend = false;
+            criticalSec_vBegin();
+            attn_vSetCause(ATTN_CAUSE_FRAME);
+            criticalSec_vEnd();
+        }
+        // イベント通知判定
         u8EventMap = evt_u8GetEventMap();
+        // 描画イベントは描画間隔毎にまとめる
+        u8EventMap = lcd_u8FrameEvent(u8EventMap);
         if (u8EventMap == EVT_NONE) {
             continue;
         }
-        // dRgXgݒ
+        // 電源コントラスト設定
         if ((u8EventMap & EVT_PW_CONTRAST) == EVT_PW_CONTRAST) {
-            // dƃRgXgݒ
+            // 電源とコントラスト設定
             lcd_vPowerSetting(sMemoryMap.u8Power);
-            // RgXgύX
-            ST7032_vSetContrastSSP2(sMemoryMap.u8Contrast);
+            // コントラスト変更
+            ST7032_vSetContrast(&sLcd, sMemoryMap.u8Contrast);
         }
-        // J[\ݒ
+        // カーソル設定
         if ((u8EventMap & EVT_CURSOR_SET) == EVT_CURSOR_SET) {
             lcd_vCursorSetting(sMemoryMap.u8CursorType);
         }
-        // J[\`攻
+        // カーソル描画判定
         if ((u8EventMap & EVT_CURSOR_DRAW) == EVT_CURSOR_DRAW) {
             lcd_vDrawCursor();
         }
-        // Psڕ`攻
-        if ((u8EventMap & EVT_DRAW_LINE_0) == EVT_DRAW_LINE_0) {
-            lcd_vDarwLine(0);
-        }
-        // Qsڕ`攻
-        if ((u8EventMap & EVT_DRAW_LINE_1) == EVT_DRAW_LINE_1) {
-            lcd_vDarwLine(1);
+        // 行描画判定
+        if ((u8EventMap & (EVT_DRAW_LINE_0 | EVT_DRAW_LINE_1)) != 0x00) {
+            // １行目描画判定
+            if ((u8EventMap & EVT_DRAW_LINE_0) == EVT_DRAW_LINE_0) {
+                lcd_vDarwLine(0);
+            }
+            // ２行目描画判定
+            if ((u8EventMap & EVT_DRAW_LINE_1) == EVT_DRAW_LINE_1) {
+                lcd_vDarwLine(1);
+            }
+            // 変更されたセルのみLCDへ送信（送信完了を待たずに次の処理へ進む）
+            ST7032_vFlush(&sLcd);
         }
-        // CGRAMւ̏ݔ
+        // CGRAMへの書き込み判定
         if ((u8EventMap & EVT_SET_CGRAM) == EVT_SET_CGRAM) {
-            // CGRAMւ̏
+            // CGRAMへの書き込み
             lcd_vDrawCGRAM();
         }
-        // ICON RAMւ̏ݔ
+        // ICON RAMへの書き込み判定
         if ((u8EventMap & EVT_DRAW_ICON) == EVT_DRAW_ICON) {
-            // ICON RAMւ̏
+            // ICON RAMへの書き込み
             lcd_vDrawIconRAM();
         }
+        // 確定した描画の完了はLCDへの送信完了後に通知（確定を伴わない描画は通知しない）
+        if ((u8EventMap & EVT_FRAME_MASK) != 0x00) {
+            criticalSec_vBegin();
+            if (sAppStatus.bFrameCommit) {
+                sAppStatus.bFrameCommit = false;
+                sAppStatus.bFramePend   = true;
+            }
+            criticalSec_vEnd();
+        }
     }
 }
 
@@ -333,10 +657,10 @@ void main() {
  *
  * NAME: evt_vSetEventMap
  *
- * DESCRIPTION:Cxg}bvݒ
+ * DESCRIPTION:イベントマップ設定
  *
  * PARAMETERS:      Name            RW  Usage
- * teEventType      eEvtType        R   ݒ肷Cxg}bv
+ * teEventType      eEvtType        R   設定するイベントマップ
  * 
  * RETURNS:
  *
@@ -348,56 +672,37 @@ static void evt_vSetEventMap(teEventType eEvtType) {
     sAppStatus.u8EventMap = sAppStatus.u8EventMap | eEvtType;
 }
 
-/*******************************************************************************
- *
- * NAME: evt_vSetDrawEvent
- *
- * DESCRIPTION:`Cxgݒ
- *
- * PARAMETERS:      Name            RW  Usage
- *       uint8      u8Addr          R   `˗AhX
- * 
- * RETURNS:
- *
- * NOTES:
- *  None.
- ******************************************************************************/
-static void evt_vSetDrawEvent(uint8 u8Addr) {
-    // w肳ꂽs̕`Cxg
-    if (u8Addr < 40) {
-        evt_vSetEventMap(EVT_DRAW_LINE_0);
-    } else {
-        evt_vSetEventMap(EVT_DRAW_LINE_1);
-    }    
-}
-
 /*******************************************************************************
  *
  * NAME: evt_u8GetEventMap
  *
- * DESCRIPTION:Cxg}bv擾
+ * DESCRIPTION:イベントマップ取得処理
  *
  * PARAMETERS:      Name            RW  Usage
  *
  * RETURNS:
- *    uint8:Cxg}bv
+ *    uint8:イベントマップ
  *
  * NOTES:
- *  None.
+ *  受信バッファに未処理のデータ又は保留中のイベント（描画間隔の経過待ちを
+ *  含む）が残っている間と、描画の完了を通知するまでは処理中ステータスを維持する。
  ******************************************************************************/
 static uint8 evt_u8GetEventMap() {
-    // NeBJZNV̊Jn
+    // クリティカルセクションの開始
     criticalSec_vBegin();
-    // }bvXe[^XXV
+    // マップステータス更新
     uint8 u8EvtMap = sAppStatus.u8EventMap;
-    if (sAppStatus.u8EventMap == EVT_NONE) {
+    if (sAppStatus.u8EventMap == EVT_NONE && u8RxHead == u8RxTail
+            && sAppStatus.u8PendEvent == EVT_NONE && sAppStatus.u8DirectEvent == EVT_NONE
+            && sAppStatus.u8FrameEvent == EVT_NONE
+            && !sAppStatus.bFramePend) {
         sMemoryMap.eStatus = MEM_STS_NORMAL;
     } else {
         sAppStatus.u8EventMap = EVT_NONE;
     }
-    // NeBJZNV̏I
+    // クリティカルセクションの終了
     criticalSec_vEnd();
-    // Cxg}bvԋp
+    // イベントマップを返却
     return u8EvtMap;
 }
 
@@ -405,10 +710,10 @@ static uint8 evt_u8GetEventMap() {
  *
  * NAME: lcd_vPowerSetting
  *
- * DESCRIPTION:dݒ菈
+ * DESCRIPTION:電源設定処理
  *
  * PARAMETERS:      Name            RW  Usage
- *       uint8      u8Settings      R   J[\^Cv
+ *       uint8      u8Settings      R   カーソルタイプ
  *
  * RETURNS:
  *
@@ -417,28 +722,32 @@ static uint8 evt_u8GetEventMap() {
  ******************************************************************************/
 static void lcd_vPowerSetting(uint8 u8Settings) {
     //==========================================================================
-    // NeBJZNV
+    // クリティカルセクション
     //==========================================================================
     criticalSec_vBegin();
-    // J[\ʒu̎擾
+    // カーソル位置情報の取得
     uint8 u8Val = sMemoryMap.u8Power;
     sMemoryMap.u8Power = sMemoryMap.u8Power | 0x01;
+    // 更新後のメモリマップから先読みし直す
+    ssp1_vPrefetch();
     criticalSec_vEnd();
     
     //==========================================================================
-    // d
+    // 電源処理
     //==========================================================================
-    // dIt
+    // 電源オフ判定
     if ((u8Val & 0x01) == 0x00) {
-        // Zbgs
+        // 送信中の描画の完了を待ってコントローラの状態を破棄
+        ST7032_vInvalidate(&sLcd);
+        // リセット実行
         PIN_POWER = OFF;
         __delay_ms(1);
         PIN_POWER = ON;
         __delay_ms(40);
-        // LCD
-        ST7032_vInitSSP2();
+        // LCD初期化処理
+        ST7032_vInit(&sLcd, I2C_BUS_SSP2, ST7032_I2C_ADDR);
     }
-    // obNCgݒ
+    // バックライト設定
     if ((u8Val & 0x02) == 0x00) {
         PIN_BACK_LIGHT = OFF;
     } else {
@@ -450,10 +759,10 @@ static void lcd_vPowerSetting(uint8 u8Settings) {
  *
  * NAME: lcd_vCursorSetting
  *
- * DESCRIPTION:J[\ݒ`揈
+ * DESCRIPTION:カーソル設定描画処理
  *
  * PARAMETERS:      Name            RW  Usage
- *       uint8      u8CursorType    R   J[\^Cv
+ *       uint8      u8CursorType    R   カーソルタイプ
  *
  * RETURNS:
  *
@@ -461,18 +770,18 @@ static void lcd_vPowerSetting(uint8 u8Settings) {
  *  None.
  ******************************************************************************/
 static void lcd_vCursorSetting(uint8 u8CursorType) {
-    // J[\\ݒ̎擾
+    // カーソル表示設定の取得
     bool bCursorDisp = u8CursorType & 0x01;
     bool bCursorBlink = (u8CursorType >> 1) & 0x01;
-    // J[\\ݒ
-    ST7032_vDispSettingSSP2(true, bCursorDisp, bCursorBlink);
+    // カーソル表示設定
+    ST7032_vDispSetting(&sLcd, true, bCursorDisp, bCursorBlink);
 }
 
 /*******************************************************************************
  *
  * NAME: lcd_vDrawCursor
  *
- * DESCRIPTION:J[\`揈
+ * DESCRIPTION:カーソル描画処理
  *
  * PARAMETERS:      Name            RW  Usage
  *
@@ -482,72 +791,99 @@ static void lcd_vCursorSetting(uint8 u8CursorType) {
  *  None.
  ******************************************************************************/
 static void lcd_vDrawCursor() {
-    // NeBJZNV̊Jn
+    // クリティカルセクションの開始
     criticalSec_vBegin();
-    // J[\ʒu̎擾
+    // カーソル位置情報の取得
     uint8 u8CursorRow = sMemoryMap.u8CursorRow;
     uint8 u8CursorCol = sMemoryMap.u8CursorCol;
-    // NeBJZNV̏I
+    // クリティカルセクションの終了
     criticalSec_vEnd();
-    // J[\ĕ`
-    ST7032_bSetCursorSSP2(u8CursorRow, u8CursorCol);
+    // カーソル再描画
+    ST7032_bSetCursor(&sLcd, u8CursorRow, u8CursorCol);
+}
+
+/*******************************************************************************
+ *
+ * NAME: lcd_u8FrameEvent
+ *
+ * DESCRIPTION:描画イベントの間引き処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *       uint8      u8EventMap      R   イベントマップ
+ *
+ * RETURNS:
+ *     uint8:今回処理するイベントマップ
+ *
+ * NOTES:
+ *  描画イベントを蓄積し、前回の描画から描画間隔（タイマーイベント数）が
+ *  経過している場合のみまとめて返す。描画間隔が0の場合は即時に返す。
+ ******************************************************************************/
+static uint8 lcd_u8FrameEvent(uint8 u8EventMap) {
+    uint8 u8Interval = sMemoryMap.u8FrameInterval;
+    // 前回の描画からの経過時間をカウント
+    if ((u8EventMap & EVT_TIMER) != 0x00 && sAppStatus.u8FrameCnt < u8Interval) {
+        sAppStatus.u8FrameCnt++;
+    }
+    // 描画イベントを蓄積
+    sAppStatus.u8FrameEvent = sAppStatus.u8FrameEvent | (u8EventMap & EVT_FRAME_MASK);
+    u8EventMap = u8EventMap & ~EVT_FRAME_MASK;
+    // 描画間隔の経過判定
+    if (sAppStatus.u8FrameEvent != EVT_NONE && sAppStatus.u8FrameCnt >= u8Interval) {
+        u8EventMap = u8EventMap | sAppStatus.u8FrameEvent;
+        sAppStatus.u8FrameEvent = EVT_NONE;
+        sAppStatus.u8FrameCnt   = 0;
+    }
+    return u8EventMap;
 }
 
 /*******************************************************************************
  *
  * NAME: lcd_vDarwLine
  *
- * DESCRIPTION:s`揈
+ * DESCRIPTION:行描画処理
  *
  * PARAMETERS:      Name            RW  Usage
- *       uint8      u8RowNo         R   `Ώۍsԍ
+ *       uint8      u8RowNo         R   描画対象行番号
  *
  * RETURNS:
  *
  * NOTES:
- *  None.
+ *  シャドウ表示データへの反映のみ行い、LCDへの送信はST7032_vFlushで行う。
+ *  表示文字RAMは割り込みで更新されるが、書き込み途中の行はトランザクションの
+ *  終了時の描画イベントで描画し直す為、割り込みは禁止しない（送信中の描画の
+ *  完了待ちは割り込みで進む）。
  ******************************************************************************/
 static void lcd_vDarwLine(uint8 u8RowNo) {
-    //==========================================================================
-    // }bv̕`f[^擾
-    //==========================================================================
-    // NeBJZNV̊Jn
-    criticalSec_vBegin();
-    // `揈
-    uint8 u8Msg[16];
-    memcpy(u8Msg, &sMemoryMap.u8DispRam[u8RowNo * 40], 16);
-    // NeBJZNV̏I
-    criticalSec_vEnd();
-    
-    //==========================================================================
-    // s`揈
-    //==========================================================================
-    // J[\ړ
-    ST7032_bSetCursorSSP2(u8RowNo, 0);
-    // s`揈
-    ST7032_vWriteDataSSP2(u8Msg, 16);
-    // J[\ĕ`
-    lcd_vDrawCursor();
+    // マップの描画データをシャドウ表示データへ反映
+    ST7032_bSetShadow(&sLcd, u8RowNo, 0, &sMemoryMap.u8DispRam[u8RowNo * 40], 16);
 }
 
 /*******************************************************************************
  *
  * NAME: lcd_vDrawCGRAM
  *
- * DESCRIPTION:CGRAM
+ * DESCRIPTION:CGRAM書き込み
  *
  * PARAMETERS:      Name            RW  Usage
  *
  * RETURNS:
  *
  * NOTES:
- *  None.
+ *  前回の書き込み以降に更新されたユーザー文字のみ書き込む。
  ******************************************************************************/
 static void lcd_vDrawCGRAM() {
+    // クリティカルセクションの開始
+    criticalSec_vBegin();
+    // 更新ユーザー文字の取得
+    uint8 u8Mask = sAppStatus.u8CGRamMask;
+    sAppStatus.u8CGRamMask = 0x00;
+    // クリティカルセクションの終了
+    criticalSec_vEnd();
+    // 更新されたユーザー文字のみ書き込み
     uint8 u8Idx;
     for (u8Idx = 0; u8Idx < 8; u8Idx++) {
-        if (sMemoryMap.u8CGRam[u8Idx * 8] < 0x20) {
-            ST7032_vWriteCGRAMSSP2(u8Idx, &sMemoryMap.u8CGRam[u8Idx * 8]);
+        if ((u8Mask & (0x01 << u8Idx)) != 0x00 && sMemoryMap.u8CGRam[u8Idx * 8] < 0x20) {
+            ST7032_vWriteCGRAM(&sLcd, u8Idx, &sMemoryMap.u8CGRam[u8Idx * 8]);
         }
     }
 }
@@ -556,7 +892,7 @@ static void lcd_vDrawCGRAM() {
  *
  * NAME: lcd_vDrawIconRAM
  *
- * DESCRIPTION:ICON RAM
+ * DESCRIPTION:ICON RAM書き込み
  *
  * PARAMETERS:      Name            RW  Usage
  *
@@ -566,17 +902,22 @@ static void lcd_vDrawCGRAM() {
  *  None.
  ******************************************************************************/
 static void lcd_vDrawIconRAM() {
-    uint8 u8Idx;
-    for (u8Idx = 0; u8Idx < MAP_ICONRAM_SIZE; u8Idx++) {
-        ST7032_vWriteIconSSP2(u8Idx, sMemoryMap.u8IconRam[u8Idx]);
-    }
+    // クリティカルセクションの開始
+    criticalSec_vBegin();
+    // 更新アイコンの取得
+    uint16 u16Mask = sAppStatus.u16IconMask;
+    sAppStatus.u16IconMask = 0x0000;
+    // クリティカルセクションの終了
+    criticalSec_vEnd();
+    // 更新されたアイコンのみ一括で書き込み
+    ST7032_vWriteIcons(&sLcd, sMemoryMap.u8IconRam, u16Mask);
 }
 
 /*******************************************************************************
  *
  * NAME: timer_vInterrupt
  *
- * DESCRIPTION:^C}[荞ݏ
+ * DESCRIPTION:タイマー割り込み処理
  *
  * PARAMETERS:      Name            RW  Usage
  *
@@ -586,370 +927,719 @@ static void lcd_vDrawIconRAM() {
  *  None.
  ******************************************************************************/
 static void timer_vInterrupt() {
-    // ^C}[O̊荞݂̗L𔻒
+    // タイマー０の割り込みの有無を判定
     if (TMR0IF != 1) {
         return;
     }
-    // ^C}[JE^
-    TMR0   = 0;                 // ^C}[0̃JE^
-    TMR0IF = 0;                 // ^C}[0tOZbg
-    // b128̊荞݂z
-    // ݔ̉񐔂JEg
+    // タイマーカウンタ
+    TMR0   = 0;                 // タイマー0のカウンタ初期化
+    TMR0IF = 0;                 // タイマー0割込フラグをリセット
+    // 秒間128回の割り込みを想定
+    // 割込み発生の回数をカウントする
+    sAppStatus.u8Tick++;
     if (sAppStatus.u8TimerCnt < 128) {
         sAppStatus.u8TimerCnt++;
     } else {
         sAppStatus.u8TimerCnt = 0;
     }
-    // ^C}[Cxg
-    // b128̊荞݂z肵Ab64Cxg
+    // タイマーイベント
+    // 秒間128回の割り込みを想定し、秒間64回イベント発生
     if ((sAppStatus.u8TimerCnt % 2) == 0) {
         evt_vSetEventMap(EVT_TIMER);
     }
-    // L[lXV
-    KEYPAD_bUpdateBuffer();
-    uint8 u8KeyNo = KEYPAD_u8Read();
-    if (u8KeyNo != 0xFF) {
+    // キー走査（１回の割り込みで１行ずつ走査し、確定したキーイベントは
+    // key_vDispatchEventへ通知される）
+    KEYPAD_u8ScanStep();
+    // ゴーストの検出状態
+    if (KEYPAD_bGhost()) {
+        sMemoryMap.u8KeyFlags = KEY_FLG_GHOST;
+    } else {
+        sMemoryMap.u8KeyFlags = 0x00;
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: key_vDispatchEvent
+ *
+ * DESCRIPTION:キーイベントの配信
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *      uint8       u8KeyNo         R   キー番号
+ *      uint8       u8Type          R   イベント種別（KEYPAD_EVT_*）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ *  キーパッドの走査処理から通知されたキーイベントを、キー値レジスタと
+ *  キー状態レジスタ、キーイベントFIFOへ同じ内容で反映する。
+ ******************************************************************************/
+static void key_vDispatchEvent(uint8 u8KeyNo, uint8 u8Type) {
+    // キー値（最終値）は押下、長押し、リピートで更新
+    if (u8Type != KEYPAD_EVT_RELEASE) {
         sMemoryMap.u8KeyValue = u8KeyNo;
     }
+    // キー状態は押下と解放で更新
+    if (u8Type == KEYPAD_EVT_PRESS || u8Type == KEYPAD_EVT_RELEASE) {
+        uint16 u16State = KEYPAD_u16ReadPressed();
+        sMemoryMap.u8KeyState[0] = (uint8)u16State;
+        sAppStatus.u8KeyStateHi  = (uint8)(u16State >> 8);
+    }
+    // キーイベントFIFOへ追加
+    key_vPushEvent(u8KeyNo, u8Type);
 }
 
 /*******************************************************************************
  *
- * NAME: ssp1_vCallback
+ * NAME: attn_vSetCause
  *
- * DESCRIPTION:I2C荞݂̃R[obN֐
+ * DESCRIPTION:通知要因の追加
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *      uint8       u8Cause         R   通知要因（ATTN_CAUSE_*）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ *  割り込みと競合する為、主処理からはクリティカルセクション内で呼び出す。
+ ******************************************************************************/
+static void attn_vSetCause(uint8 u8Cause) {
+    sMemoryMap.u8AttnCause = sMemoryMap.u8AttnCause | u8Cause;
+    attn_vUpdate();
+}
+
+/*******************************************************************************
+ *
+ * NAME: attn_vUpdate
+ *
+ * DESCRIPTION:通知ピンの更新
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ *  マスクされていない通知要因があればピンをLowに駆動し、無ければ開放する。
+ *  他ピンの読み書きでラッチが変化していても確実にLowを出力する様に、
+ *  出力に切り替える直前にラッチを0に戻す。
+ *  割り込みと競合する為、主処理からはクリティカルセクション内で呼び出す。
+ ******************************************************************************/
+static void attn_vUpdate() {
+    if ((sMemoryMap.u8AttnCause & sMemoryMap.u8AttnMask) != 0x00) {
+        PIN_ATTN_LAT  = 0;
+        PIN_ATTN_TRIS = 0;
+    } else {
+        PIN_ATTN_TRIS = 1;
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: key_vPushEvent
+ *
+ * DESCRIPTION:キーイベントの追加
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *      uint8       u8KeyNo         R   キー番号
+ *      uint8       u8Type          R   イベント種別（KEYPAD_EVT_*）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ *  FIFOが一杯の場合はイベントを破棄して溢れフラグを立てる。
+ ******************************************************************************/
+static void key_vPushEvent(uint8 u8KeyNo, uint8 u8Type) {
+    uint8 u8Cnt = sMemoryMap.u8KeyEvtCnt & KEY_FIFO_CNT_MASK;
+    // 溢れ判定
+    if (u8Cnt >= KEY_FIFO_SIZE) {
+        sMemoryMap.u8KeyEvtCnt = sMemoryMap.u8KeyEvtCnt | KEY_FIFO_OVERFLOW;
+        return;
+    }
+    // イベント種別とキー番号、タイムスタンプを末尾に追加
+    uint8 *pu8Event = &sMemoryMap.u8KeyEvent[u8Cnt * KEY_EVT_SIZE];
+    pu8Event[0] = (uint8)(u8Type << KEY_EVT_TYPE_SHIFT) | u8KeyNo;
+    pu8Event[1] = sAppStatus.u8Tick;
+    sMemoryMap.u8KeyEvtCnt++;
+    // ホストへ通知
+    attn_vSetCause(ATTN_CAUSE_KEY);
+}
+
+/*******************************************************************************
+ *
+ * NAME: key_vPopEvent
+ *
+ * DESCRIPTION:読み込み済みキーイベントの取り出し
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ *  読み出しトランザクションの終了時に、最後まで送信したキーイベントを
+ *  FIFOから取り除いて残りを先頭に詰める。途中でNACKされたイベントは残す。
+ *  溢れフラグはホストへ送信した件数レジスタに含まれていた場合のみクリアする。
+ ******************************************************************************/
+static void key_vPopEvent() {
+    uint8 u8Pop = sAppStatus.u8KeyPopCnt;
+    // 読み込み済みイベントの有無を判定
+    if (u8Pop == 0) {
+        return;
+    }
+    sAppStatus.u8KeyPopCnt = 0;
+    uint8 u8Cnt = sMemoryMap.u8KeyEvtCnt & KEY_FIFO_CNT_MASK;
+    if (u8Pop > u8Cnt) {
+        u8Pop = u8Cnt;
+    }
+    // 残りのイベントを先頭に詰める（送信済みの溢れフラグはクリア）
+    u8Cnt = u8Cnt - u8Pop;
+    memmove(sMemoryMap.u8KeyEvent, &sMemoryMap.u8KeyEvent[u8Pop * KEY_EVT_SIZE],
+            u8Cnt * KEY_EVT_SIZE);
+    memset(&sMemoryMap.u8KeyEvent[u8Cnt * KEY_EVT_SIZE], 0x00,
+            u8Pop * KEY_EVT_SIZE);
+    sMemoryMap.u8KeyEvtCnt = u8Cnt
+        | (sMemoryMap.u8KeyEvtCnt & ~sAppStatus.u8KeyFifoCnt & KEY_FIFO_OVERFLOW);
+}
+
+/*******************************************************************************
+ *
+ * NAME: map_psGetRegion
+ *
+ * DESCRIPTION:メモリマップ領域の取得
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *      uint8       u8Addr          R   メモリマップアドレス（MAP_SIZE未満）
+ *
+ * RETURNS:
+ *     tsMapRegion*:メモリマップ領域の記述子
+ *
+ * NOTES:
+ *  領域の境界は全て8の倍数-1のアドレスにある為、ブロック番号の表引きで
+ *  アドレスに依存しない時間で領域を特定できる。
+ *  レジスタのブロック（MAP_BLOCK_REG）はブロック先頭からの位置を加算する。
+ ******************************************************************************/
+static const tsMapRegion* map_psGetRegion(uint8 u8Addr) {
+    uint8 u8Blk = (uint8)(u8Addr + 1) >> 3;
+    // 制御レジスタ判定
+    if (u8Blk == 0) {
+        return &sMapRegion[u8Addr];
+    }
+    uint8 u8Region = u8MapBlock[u8Blk];
+    // レジスタのブロック判定
+    if ((u8Region & MAP_BLOCK_REG) != 0x00) {
+        u8Region = (u8Region & ~MAP_BLOCK_REG) + ((u8Addr + 1) & 0x07);
+    }
+    return &sMapRegion[u8Region];
+}
+
+/*******************************************************************************
+ *
+ * NAME: ssp1_bCallback
+ *
+ * DESCRIPTION:I2C割り込みのコールバック関数
  *
  * PARAMETERS:      Name            RW  Usage
  *      uint8       u8BusNo         R   Bus number
  *      uint8       u8EvtType       R   Event Type
  *
  * RETURNS:
+ *    bool true:SCLラインを開放する、false:受信保留中の為保持する
  *
  * NOTES:
  *  None.
  ******************************************************************************/
-static void ssp1_vCallback(uint8 u8BusNo, uint8 u8EvtType) {
+static bool ssp1_bCallback(uint8 u8BusNo, uint8 u8EvtType) {
     uint8 u8Data = 0;
     switch (u8EvtType) {
         case I2C_SLV_EVT_WRITE_ADDR:
-            // ݗvAhXM
-            // AhXf[^ǂ݂
+            // 書き込み要求アドレス受信
+            // アドレスデータを空読みする
             u8Data = SSP1BUF;
-            // X^[gԃtOXV
+            // スタート状態フラグ更新
             sAppStatus.bWriteStartFlg = true;
             break;
         case I2C_SLV_EVT_WRITE_DATA:
-            // ݗvf[^M
-            ssp1_vWriteData((uint8)SSP1BUF);
-            // X^[gԃtOXV
-            sAppStatus.bWriteStartFlg = false;
+            // 書き込み要求データ受信
+            if (!ssp1_bReceiveData((uint8)SSP1BUF)) {
+                // 受信バッファの空き待ち（SCLラインを保持する）
+                return false;
+            }
+            // メモリマップアドレス受信判定
+            if (sAppStatus.bWriteStartFlg) {
+                // スタート状態フラグ更新
+                sAppStatus.bWriteStartFlg = false;
+                // SCLラインの開放後に新しいアドレスのデータを先読みする
+                sAppStatus.bPrefetchReq = true;
+            }
             break;
         case I2C_SLV_EVT_READ_ADDR:
-            // ǂݏovAhXM
-            // AhXf[^ǂ݂
+            // 読み出し要求アドレス受信
+            // アドレスデータを空読みする
             u8Data = SSP1BUF;
-            // ǂݏo
+            // キーイベントFIFOの送信位置と送信した件数をクリア
+            sAppStatus.u8KeyFifoNext = 0;
+            sAppStatus.u8KeyFifoCnt  = 0;
+            // 読み出し処理（先読み済みデータを送信）
             SSP1BUF = ssp1_u8ReadData();
+            // SCLラインの開放後に次のデータを先読みする
+            sAppStatus.bPrefetchReq = true;
             break;
         case I2C_SLV_EVT_READ_ACK:
-            // ǂݏovACKM
+            // 読み出し要求ACK応答受信
             SSP1BUF = ssp1_u8ReadData();
+            // SCLラインの開放後に次のデータを先読みする
+            sAppStatus.bPrefetchReq = true;
             break;
         case I2C_SLV_EVT_READ_NACK:
-            // ǂݏovNACKM
-            // ǂݏoȂ̂ŕԐMȂ
+            // 読み出し要求NACK応答受信
+            // 読み出し完了なので返信せず、送信済みのキーイベントを取り出す
+            key_vPopEvent();
             break;
         default:
-            // X^[gԃtOXV
+            // トランザクション終了（ストップコンディション、バスエラー）
+            // ここまでの受信データを確定する
+            u8RxCommit = u8RxHead;
+            // 直接反映したデータのイベントを通知
+            if (sAppStatus.u8DirectEvent != EVT_NONE) {
+                evt_vSetEventMap(sAppStatus.u8DirectEvent);
+                sAppStatus.u8DirectEvent = EVT_NONE;
+            }
+            // 送信済みのキーイベントを取り出す
+            key_vPopEvent();
+            // スタート状態フラグ更新
             sAppStatus.bWriteStartFlg = false;
             break;
     }
+    return true;
 }
 
 /*******************************************************************************
  *
- * NAME: ssp1_vWriteData
+ * NAME: ssp1_bReceiveData
  *
- * DESCRIPTION:݃NGXg
+ * DESCRIPTION:書き込みデータ受信処理
  *
  * PARAMETERS:      Name            RW  Usage
- *      uint8       u8Data          R   ݃f[^
+ *      uint8       u8Data          R   受信データ
  *
  * RETURNS:
+ *    bool true:処理完了、false:受信バッファが一杯の為保留
  *
  * NOTES:
- *  None.
+ *  割り込み中に実行される為、入力チェックのみ行い受信バッファへ格納する。
+ *  メモリマップへの反映はssp1_vProcRxBuffで主処理から行う。
+ *  連続書き込みでは書き込み中の領域の終端と上限、属性を保持し、1バイト毎の
+ *  領域判定を省略する。受信バッファが一杯の場合はNACKせずにレコードを
+ *  保留し、主処理が空きを作ってから格納してSCLラインを開放する。
+ *  表示文字/ユーザー文字/アイコンRAMと描画制御への書き込みは、１行分の
+ *  書き込みで受信バッファが溢れない様に、SCLラインの開放後に割り込みで直接
+ *  反映する（ssp1_vWriteDirect）。電源設定のレコードが未反映の間は、
+ *  メモリマップの初期化と順序が入れ替わらない様に受信バッファへ格納し、
+ *  同期レコードとして反映されるまで直接反映を止める。
  ******************************************************************************/
-static void ssp1_vWriteData(uint8 u8Data) {
+static bool ssp1_bReceiveData(uint8 u8Data) {
     //==========================================================================
-    // AhXݒiX^[gԒj̏
+    // アドレス設定（スタート状態直後）の処理
     //==========================================================================
     if (sAppStatus.bWriteStartFlg) {
-        // AhXG[
+        // アドレスエラー判定
         if (u8Data < MAP_SIZE) {
-            // M}bvAhXݒ(ACKPICIɕԐM)
+            // 受信したメモリマップアドレスを設定(ACKはPICが自動的に返信する)
             sAppStatus.u8MapAddr = u8Data;
+            // 書き込み中の領域をクリア
+            sAppStatus.u8WriteEnd = 0x00;
         } else {
-            // I[o[t[
-            // NACKԐM
+            // メモリオーバーフロー
+            // NACK返信する
             SSP1CON2bits.ACKDT = 0x01;
         }
-        // I
-        return;
+        // 終了
+        return true;
     }
 
     //==========================================================================
-    // ̈ւ̏
+    // 入力チェック
     //==========================================================================
-    // AhXG[
-    if (sAppStatus.u8MapAddr >= MAP_SIZE) {
-        // NACKԐM
+    uint8 u8Addr = sAppStatus.u8MapAddr;
+    // 領域の境界を越えた場合のみ領域の情報を取得し直す
+    if (u8Addr >= sAppStatus.u8WriteEnd) {
+        // アドレスエラー判定
+        if (u8Addr >= MAP_SIZE) {
+            // NACK返信する
+            SSP1CON2bits.ACKDT = 0x01;
+            // 終了
+            return true;
+        }
+        const tsMapRegion *psRegion = map_psGetRegion(u8Addr);
+        sAppStatus.u8WriteEnd = psRegion->u8Base + psRegion->u8Len;
+        sAppStatus.u8WriteMax = psRegion->u8Max;
+        sAppStatus.u8WriteFlg = psRegion->u8Flags;
+    }
+    // 値の範囲（領域毎の上限）を判定
+    if (u8Data > sAppStatus.u8WriteMax) {
+        // NACK返信する
         SSP1CON2bits.ACKDT = 0x01;
-        // I
-        return;
+        // 終了
+        return true;
     }
-    // AhX
-    uint8 u8Addr;
-    // ̈攻
-    switch (sAppStatus.u8MapAddr) {
-        case 0x00:
-            // Xe[^Xiǂݍݐpj
-            break;
-        case 0x01:
-            // L[l
-            sMemoryMap.u8KeyValue = u8Data;
-            break;
-        case 0x02:
-            // dݒ
-            if (u8Data > 0x03) {
-                // NACKԐM
-                SSP1CON2bits.ACKDT = 0x01;
-                // I
-                return;
-            }
-            // l̍XV
-            if (sMemoryMap.u8Power != u8Data) {
-                // dIt
-                if ((u8Data & 0x01) == 0x00) {
-                    // ֘Ap[^
-                    sMemoryMap.u8Power      = 0x00;             // LCDd
-                    sMemoryMap.u8Contrast   = LCD_CONTRAST_DEF; // LCDRgXg
-                    sMemoryMap.u8CursorType = 0x00;             // J[\^Cv
-                    sMemoryMap.u8CursorRow  = 0x00;             // J[\s
-                    sMemoryMap.u8CursorCol  = 0x00;             // J[\
-                    memset(sMemoryMap.u8DispRam, 0x00, MAP_DATA_SIZE);      // \RAM
-                    memset(sMemoryMap.u8CGRam, 0xE0, MAP_CGRAM_SIZE);       // [U[RAM
-                    memset(sMemoryMap.u8IconRam, 0x00, MAP_ICONRAM_SIZE);   // ACRRAM
-                } else {
-                    // obNCgXV
-                    sMemoryMap.u8Power = u8Data;
-                }
-                // Cxg̒ʒm
-                evt_vSetEventMap(EVT_PW_CONTRAST);
-            }
-            break;
-        case 0x03:
-            // RgXgݒ
-            if (u8Data > ST7032_CONTRAST_MAX) {
-                // NACKԐM
-                SSP1CON2bits.ACKDT = 0x01;
-                // I
-                return;
-            }
-            // l̍XV
-            if (sMemoryMap.u8Contrast != u8Data) {
-                // RgXgXV
-                sMemoryMap.u8Contrast = u8Data;
-                // Cxg̒ʒm
-                evt_vSetEventMap(EVT_PW_CONTRAST);
-            }
-            break;
-        case 0x04:
-            // J[\^Cv
-            // ̓`FbN
-            if (u8Data > 0x03) {
-                // NACKԐM
-                SSP1CON2bits.ACKDT = 0x01;
-                // I
-                return;
-            }
-            // J[\^Cv
-            if (sMemoryMap.u8CursorType != u8Data) {
-                // J[\sXV
-                sMemoryMap.u8CursorType = u8Data;
-                // Cxg̒ʒm
-                evt_vSetEventMap(EVT_CURSOR_SET);
-            }
-            break;
-        case 0x05:
-            // J[\s
-            // ̓`FbN
-            if (u8Data > ST7032_ROW_MAX) {
-                // NACKԐM
-                SSP1CON2bits.ACKDT = 0x01;
-                // I
-                return;
-            }
-            // J[\ړ
-            if (sMemoryMap.u8CursorRow != u8Data) {
-                // J[\sXV
-                sMemoryMap.u8CursorRow = u8Data;
-                // Cxg̒ʒm
-                evt_vSetEventMap(EVT_CURSOR_DRAW);
-            }
-            break;
-        case 0x06:
-            // J[\
-            // ̓`FbN
-            if (u8Data > ST7032_COL_MAX) {
-                // NACKԐM
-                SSP1CON2bits.ACKDT = 0x01;
-                // I
-                return;
-            }
-            // J[\ړ
-            if (sMemoryMap.u8CursorCol != u8Data) {
-                // J[\XV
-                sMemoryMap.u8CursorCol = u8Data;
-                // Cxg̒ʒm
-                evt_vSetEventMap(EVT_CURSOR_DRAW);
-            }
+    // 反映完了まで処理中とする
+    sMemoryMap.eStatus = MEM_STS_PROCESSING;
+    // メモリマップアドレスカウントアップ
+    sAppStatus.u8MapAddr++;
+    // 同期レコードの判定
+    uint8 u8Flags = 0x00;
+    if ((sAppStatus.u8WriteFlg & (MAP_FLG_HOLD | MAP_FLG_DRAW_CTRL)) != 0x00) {
+        // 未反映の同期レコードが無ければSCLラインの開放後に直接反映する
+        if (u8RxSyncCnt == 0) {
+            sAppStatus.u8DirectAddr = u8Addr;
+            sAppStatus.u8DirectData = u8Data;
+            return true;
+        }
+        u8Flags = RX_FLG_SYNC;
+    } else if ((sAppStatus.u8WriteFlg & MAP_FLG_POWER) != 0x00) {
+        u8Flags = RX_FLG_SYNC;
+    }
+    // 同期レコードは受信バッファへの格納前から数える
+    if (u8Flags != 0x00) {
+        u8RxSyncCnt++;
+    }
+    // 受信バッファの空きを判定
+    uint8 u8Head = u8RxHead;
+    if ((uint8)(u8Head - u8RxTail) >= RX_BUFF_SIZE) {
+        // 空きができるまでレコードを保留する（SCLラインを保持してACKを待たせる）
+        sAppStatus.u8HoldAddr  = u8Addr;
+        sAppStatus.u8HoldData  = u8Data;
+        sAppStatus.u8HoldFlags = u8Flags;
+        sAppStatus.bRxHold     = true;
+        return false;
+    }
+
+    //==========================================================================
+    // 受信バッファへの格納
+    //==========================================================================
+    sRxBuff[u8Head & RX_BUFF_MASK].u8Addr  = u8Addr;
+    sRxBuff[u8Head & RX_BUFF_MASK].u8Data  = u8Data;
+    sRxBuff[u8Head & RX_BUFF_MASK].u8Flags = u8Flags;
+    // レコードを書き込んでから書き込み位置を公開する
+    u8RxHead = u8Head + 1;
+    return true;
+}
+
+/*******************************************************************************
+ *
+ * NAME: ssp1_vWriteDirect
+ *
+ * DESCRIPTION:受信データの直接反映処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ *  ssp1_bReceiveDataで直接反映とした書き込みデータを、SCLラインの開放後に
+ *  割り込み内でメモリマップへ反映する。イベントはトランザクションの終了時に
+ *  まとめて通知する。反映したアドレスの先読みデータは破棄する。
+ ******************************************************************************/
+static void ssp1_vWriteDirect() {
+    uint8 u8Addr = sAppStatus.u8DirectAddr;
+    sAppStatus.u8DirectAddr = READ_ADDR_NONE;
+    // 先読みデータの破棄
+    if (sAppStatus.u8ReadAddr == u8Addr) {
+        sAppStatus.u8ReadAddr = READ_ADDR_NONE;
+    }
+    // メモリマップへ反映し、イベントはトランザクション終了まで保留
+    sAppStatus.u8DirectEvent |= ssp1_u8WriteData(u8Addr, sAppStatus.u8DirectData);
+}
+
+/*******************************************************************************
+ *
+ * NAME: ssp1_vProcRxBuff
+ *
+ * DESCRIPTION:受信バッファ処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ *  受信バッファの全レコードをメモリマップへ反映する。イベントはストップ
+ *  コンディションまでのレコードを反映した時点でまとめて通知し、1回の
+ *  トランザクションの描画を1回にする。
+ ******************************************************************************/
+static void ssp1_vProcRxBuff() {
+    uint8 u8Tail = u8RxTail;
+    bool bUpdate = false;
+    // 受信済みレコードを順に反映
+    while (true) {
+        // 確定位置まで反映した場合は保留中のイベントをまとめて通知
+        if (u8Tail == u8RxCommit && sAppStatus.u8PendEvent != EVT_NONE) {
+            criticalSec_vBegin();
+            evt_vSetEventMap(sAppStatus.u8PendEvent);
+            criticalSec_vEnd();
+            sAppStatus.u8PendEvent = EVT_NONE;
+        }
+        // 未処理レコードの有無を判定
+        if (u8Tail == u8RxHead) {
             break;
-        default:
-            // Ώۃf[^
-            if (sAppStatus.u8MapAddr < MAP_ADDR_CGRAM) {
-                // \f[^XV
-                u8Addr = sAppStatus.u8MapAddr - MAP_ADDR_DISPLAY;
-                if (sMemoryMap.u8DispRam[u8Addr] == u8Data) {
-                    break;
-                }
-                // \f[^ݒ
-                sMemoryMap.u8DispRam[u8Addr] = u8Data;
-                // Cxg̒ʒm
-                evt_vSetDrawEvent(u8Addr);
-            } else if (sAppStatus.u8MapAddr < MAP_ADDR_ICONRAM) {
-                // CGRAM̓`FbN
-                if (u8Data > 0x1F) {
-                    // NACKԐM
-                    SSP1CON2bits.ACKDT = 0x01;
-                    // I
-                    return;
-                }
-                // CGRAMXV
-                u8Addr = sAppStatus.u8MapAddr - MAP_ADDR_CGRAM;
-                if (sMemoryMap.u8CGRam[u8Addr] == u8Data) {
-                    break;
-                }
-                // \f[^ݒ
-                sMemoryMap.u8CGRam[u8Addr] = u8Data;
-                // Cxg̒ʒm
-                evt_vSetEventMap(EVT_SET_CGRAM);
-            } else {
-                // ICONRAM̓`FbN
-                if (u8Data > 0x1F) {
-                    // NACKԐM
-                    SSP1CON2bits.ACKDT = 0x01;
-                    // I
-                    return;
-                }
-                // ICONRAMXV
-                u8Addr = sAppStatus.u8MapAddr - MAP_ADDR_ICONRAM;
-                if (sMemoryMap.u8IconRam[u8Addr] == u8Data) {
-                    break;
-                }
-                // \f[^ݒ
-                sMemoryMap.u8IconRam[u8Addr] = u8Data;
-                // Cxg̒ʒm
-                evt_vSetEventMap(EVT_DRAW_ICON);
+        }
+        // メモリマップへ反映し、イベントはトランザクション終了まで保留
+        sAppStatus.u8PendEvent |= ssp1_u8WriteData(sRxBuff[u8Tail & RX_BUFF_MASK].u8Addr,
+                                                   sRxBuff[u8Tail & RX_BUFF_MASK].u8Data);
+        // 同期レコードの反映後に割り込みでの直接反映を再開
+        if ((sRxBuff[u8Tail & RX_BUFF_MASK].u8Flags & RX_FLG_SYNC) != 0x00) {
+            criticalSec_vBegin();
+            u8RxSyncCnt--;
+            criticalSec_vEnd();
+        }
+        // レコードの反映後に読み出し位置を更新
+        u8Tail++;
+        u8RxTail = u8Tail;
+        bUpdate = true;
+        // 空きを待っている受信保留レコードを格納して受信を再開
+        ssp1_vReleaseHold();
+    }
+    // 反映後のメモリマップから先読みし直す
+    if (bUpdate) {
+        criticalSec_vBegin();
+        ssp1_vPrefetch();
+        criticalSec_vEnd();
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: ssp1_vReleaseHold
+ *
+ * DESCRIPTION:受信保留レコードの格納とSCLラインの開放
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ *  受信バッファが一杯でSCLラインを保持している場合に、保留したレコードを
+ *  空いた受信バッファへ格納してSCLラインを開放する（ACKを返信する）。
+ *  主処理から受信バッファの空きを作った後に呼び出す。
+ ******************************************************************************/
+static void ssp1_vReleaseHold() {
+    criticalSec_vBegin();
+    if (sAppStatus.bRxHold) {
+        uint8 u8Head = u8RxHead;
+        sRxBuff[u8Head & RX_BUFF_MASK].u8Addr  = sAppStatus.u8HoldAddr;
+        sRxBuff[u8Head & RX_BUFF_MASK].u8Data  = sAppStatus.u8HoldData;
+        sRxBuff[u8Head & RX_BUFF_MASK].u8Flags = sAppStatus.u8HoldFlags;
+        u8RxHead = u8Head + 1;
+        sAppStatus.bRxHold = false;
+        // ACKDTは受信時に設定済み
+        I2C_vSlaveReleaseSSP1();
+    }
+    criticalSec_vEnd();
+}
+
+/*******************************************************************************
+ *
+ * NAME: ssp1_u8WriteData
+ *
+ * DESCRIPTION:書き込みリクエスト処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *      uint8       u8MapAddr       R   メモリマップアドレス
+ *      uint8       u8Data          R   書き込みデータ
+ *
+ * RETURNS:
+ *     uint8:通知するイベントマップ
+ *
+ * NOTES:
+ *  入力チェックは受信時（ssp1_vReceiveData）に実施済み。
+ *  表示文字/ユーザー文字/アイコンRAMと描画制御は割り込み（ssp1_vWriteDirect）
+ *  から、それ以外は主処理（ssp1_vProcRxBuff）から呼び出す。
+ *  描画制御の保持モード中は、表示文字/ユーザー文字/アイコンRAMの描画を
+ *  確定要求まで保留し、確定時に1回の描画にまとめる。
+ ******************************************************************************/
+static uint8 ssp1_u8WriteData(uint8 u8MapAddr, uint8 u8Data) {
+    // メモリマップ領域の取得
+    const tsMapRegion *psRegion = map_psGetRegion(u8MapAddr);
+    uint8 u8Idx = u8MapAddr - psRegion->u8Base;
+    uint8 *pu8Data = &psRegion->pu8Data[u8Idx];
+    uint8 u8Event;
+    // 描画制御判定
+    if ((psRegion->u8Flags & MAP_FLG_DRAW_CTRL) != 0x00) {
+        // 保持モードの更新（確定要求は保持しない）
+        sMemoryMap.u8DrawCtrl = u8Data & DRAW_CTRL_HOLD;
+        // 確定要求又は保持モード解除時は保留中の描画を通知
+        if ((u8Data & DRAW_CTRL_COMMIT) != 0x00 || (u8Data & DRAW_CTRL_HOLD) == 0x00) {
+            u8Event = sAppStatus.u8HoldEvent;
+            sAppStatus.u8HoldEvent = EVT_NONE;
+            // 確定した描画の完了を通知する
+            if (u8Event != EVT_NONE) {
+                sAppStatus.bFrameCommit = true;
             }
-            break;
+            return u8Event;
+        }
+        return EVT_NONE;
     }
-    // }bvAhXJEgAbv
-    sAppStatus.u8MapAddr++;
+    // 読み込み専用領域と値の更新判定
+    if ((psRegion->u8Flags & MAP_FLG_READONLY) != 0x00 || *pu8Data == u8Data) {
+        return EVT_NONE;
+    }
+    // 電源オフ判定
+    if ((psRegion->u8Flags & MAP_FLG_POWER) != 0x00 && (u8Data & 0x01) == 0x00) {
+        // 関連パラメータ初期化
+        sMemoryMap.u8Power      = 0x00;             // LCD電源
+        sMemoryMap.u8Contrast   = LCD_CONTRAST_DEF; // LCDコントラスト
+        sMemoryMap.u8CursorType = 0x00;             // カーソルタイプ
+        sMemoryMap.u8CursorRow  = 0x00;             // カーソル行
+        sMemoryMap.u8CursorCol  = 0x00;             // カーソル列
+        memset(sMemoryMap.u8DispRam, 0x00, MAP_DATA_SIZE);      // 表示文字RAM
+        memset(sMemoryMap.u8CGRam, 0xE0, MAP_CGRAM_SIZE);       // ユーザー文字RAM
+        memset(sMemoryMap.u8IconRam, 0x00, MAP_ICONRAM_SIZE);   // アイコンRAM
+        sMemoryMap.u8DrawCtrl   = 0x00;             // 描画制御
+        sAppStatus.u8HoldEvent  = EVT_NONE;         // 確定待ちの描画
+        sAppStatus.bFrameCommit = false;            // 確定した描画の描画待ち
+        return psRegion->u8Event;
+    }
+    // 値を更新
+    *pu8Data = u8Data;
+    // 通知要因マスクの変更を通知ピンへ反映
+    if ((psRegion->u8Flags & MAP_FLG_ATTN) != 0x00) {
+        criticalSec_vBegin();
+        attn_vUpdate();
+        criticalSec_vEnd();
+    }
+    // 更新アイコンの記録
+    if ((psRegion->u8Flags & MAP_FLG_ICON) != 0x00) {
+        sAppStatus.u16IconMask = sAppStatus.u16IconMask | (0x0001 << u8Idx);
+    }
+    // 更新ユーザー文字の記録
+    if ((psRegion->u8Flags & MAP_FLG_CGRAM) != 0x00) {
+        sAppStatus.u8CGRamMask = sAppStatus.u8CGRamMask | (0x01 << (u8Idx >> 3));
+    }
+    // 保持モード中は確定要求まで描画を保留
+    u8Event = psRegion->u8Event;
+    if ((psRegion->u8Flags & MAP_FLG_HOLD) != 0x00
+            && (sMemoryMap.u8DrawCtrl & DRAW_CTRL_HOLD) != 0x00) {
+        sAppStatus.u8HoldEvent = sAppStatus.u8HoldEvent | u8Event;
+        return EVT_NONE;
+    }
+    // イベント情報の通知
+    return u8Event;
 }
 
 /*******************************************************************************
  *
  * NAME: ssp1_u8ReadData
  *
- * DESCRIPTION:ǂݍ݃NGXg
+ * DESCRIPTION:読み込みリクエスト処理
  *
  * PARAMETERS:      Name            RW  Usage
  *
  * RETURNS:
- *     uint8:ǂݍ݃f[^
+ *     uint8:読み込みデータ
  *
  * NOTES:
- *  None.
+ *  ssp1_vPrefetchで先読みしたデータを返す。ステータスとキー値は割り込みで
+ *  変化する為（MAP_FLG_VOLATILE）、先読みせずに送信時に直接読み込む。
+ *  キー値のクリアは実際に送信する時点で行い、ホストが途中でNACKを返した場合に
+ *  未送信のキー値が失われないようにする。キーイベントFIFOは今回の読み込みで
+ *  先頭のイベントから連続して送信した件数を記録し、取り出しはトランザクションの
+ *  終了時に行う。FIFOの途中から読み込んだ場合は先頭のイベントが未送信の為、
+ *  取り出さない。通知要因は送信時に
+ *  クリアして通知ピンを開放する。キー状態は下位バイトの送信時に上位バイトを
+ *  保持し、２バイトの読み込みの間に更新されても同じ時点の値を返す。
  ******************************************************************************/
 static uint8 ssp1_u8ReadData() {
-    //==========================================================================
-    // ݃AhX̓ǂݍݏ
-    //==========================================================================
-    // I[o[t[
-    if (sAppStatus.u8MapAddr >= MAP_SIZE) {
-        // I[o[t[
-        // NACKԐM
+    uint8 u8Addr = sAppStatus.u8MapAddr;
+    uint8 u8Data;
+    uint8 u8Idx;
+    // 先読みデータの取得判定
+    if (sAppStatus.u8ReadAddr == u8Addr) {
+        // 先読み済みのデータ
+        u8Data = sAppStatus.u8ReadData;
+    } else if (u8Addr >= MAP_SIZE) {
+        // メモリオーバーフロー
+        // NACK返信する
         SSP1CON2bits.ACKDT = 0x01;
-        // I
+        // 終了
         return 0xFF;
+    } else {
+        // 先読みしていない場合はメモリマップから直接読み込む
+        const tsMapRegion *psRegion = map_psGetRegion(u8Addr);
+        uint8 *pu8Data = &psRegion->pu8Data[u8Addr - psRegion->u8Base];
+        u8Data = *pu8Data;
+        // 読み込み時の副作用
+        switch (psRegion->u8ReadFx) {
+            case MAP_READ_CLEAR:
+                // キー値のクリア
+                *pu8Data = 0xFF;
+                break;
+            case MAP_READ_KEY_FIFO:
+                // 読み込みの開始時点の件数を保持（件数の送信後に追加された
+                // イベントは件数に含まれない為、取り出さない）
+                u8Idx = u8Addr - MAP_ADDR_KEYFIFO;
+                if (u8Idx == 0 || (u8Idx == 1 && sAppStatus.u8KeyFifoNext != 1)) {
+                    sAppStatus.u8KeyFifoCnt = sMemoryMap.u8KeyEvtCnt;
+                }
+                // 今回の読み込みでFIFOの先頭から連続して送信した場合のみ、
+                // イベントの最終バイトの送信で読み込み済み件数を更新
+                if (u8Idx <= 1 || u8Idx == sAppStatus.u8KeyFifoNext) {
+                    sAppStatus.u8KeyFifoNext = u8Idx + 1;
+                    if (u8Idx != 0 && (u8Idx % KEY_EVT_SIZE) == 0) {
+                        sAppStatus.u8KeyPopCnt = u8Idx / KEY_EVT_SIZE;
+                        if (sAppStatus.u8KeyPopCnt > (sAppStatus.u8KeyFifoCnt & KEY_FIFO_CNT_MASK)) {
+                            sAppStatus.u8KeyPopCnt = sAppStatus.u8KeyFifoCnt & KEY_FIFO_CNT_MASK;
+                        }
+                    }
+                }
+                break;
+            case MAP_READ_ATTN:
+                // 通知要因のクリア
+                *pu8Data = 0x00;
+                attn_vUpdate();
+                break;
+            case MAP_READ_KEY_STATE:
+                // 下位バイトと同じ時点の上位バイトを保持
+                sMemoryMap.u8KeyState[1] = sAppStatus.u8KeyStateHi;
+                break;
+        }
     }
-    // ̈攻
-    uint8 u8Data;
-    uint8 u8Addr;
-    switch (sAppStatus.u8MapAddr) {
-        case 0x00:
-            // Xe[^Xiǂݍݐpj
-            u8Data = sMemoryMap.eStatus;
-            break;
-        case 0x01:
-            // L[liŏIl[hj
-            u8Data = sMemoryMap.u8KeyValue;
-            sMemoryMap.u8KeyValue = 0xFF;
-            break;
-        case 0x02:
-            // dݒ
-            u8Data = sMemoryMap.u8Power;
-            break;
-        case 0x03:
-            // RgXg
-            u8Data = sMemoryMap.u8Contrast;
-            break;
-        case 0x04:
-            // J[\^Cv
-            u8Data = sMemoryMap.u8CursorType;
-            break;
-        case 0x05:
-            // J[\s
-            u8Data = sMemoryMap.u8CursorRow;
-            break;
-        case 0x06:
-            // J[\
-            u8Data = sMemoryMap.u8CursorCol;
-            break;
-        default:
-            // Ώۃf[^
-            if (sAppStatus.u8MapAddr < MAP_ADDR_CGRAM) {
-                // \f[^
-                u8Addr = sAppStatus.u8MapAddr - MAP_ADDR_DISPLAY;
-                u8Data = sMemoryMap.u8DispRam[u8Addr];
-            } else if (sAppStatus.u8MapAddr < MAP_ADDR_ICONRAM) {
-                // Character Generator RAM
-                u8Addr = sAppStatus.u8MapAddr - MAP_ADDR_CGRAM;
-                u8Data = sMemoryMap.u8CGRam[u8Addr];
-            } else {
-                // ICON Ram
-                u8Addr = sAppStatus.u8MapAddr - MAP_ADDR_ICONRAM;
-                u8Data = sMemoryMap.u8IconRam[u8Addr];
-            }
-            break;
-    }
-    // }bvAhXJEgAbv
+    // メモリマップアドレスカウントアップ
     sAppStatus.u8MapAddr++;
-    // lԐM
+    // 値を返信
     return u8Data;
 }
 
+/*******************************************************************************
+ *
+ * NAME: ssp1_vPrefetch
+ *
+ * DESCRIPTION:読み込みデータの先読み処理
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ *  現在のメモリマップアドレスのデータを読み込んで保持する（副作用無し）。
+ *  ステータスとキー値、メモリマップ外のアドレスは先読みしない。
+ ******************************************************************************/
+static void ssp1_vPrefetch() {
+    uint8 u8MapAddr = sAppStatus.u8MapAddr;
+    // メモリオーバーフロー判定
+    if (u8MapAddr >= MAP_SIZE) {
+        sAppStatus.u8ReadAddr = READ_ADDR_NONE;
+        return;
+    }
+    // メモリマップ領域の取得
+    const tsMapRegion *psRegion = map_psGetRegion(u8MapAddr);
+    // 割り込みで変化する領域は送信時に読み込む
+    if ((psRegion->u8Flags & MAP_FLG_VOLATILE) != 0x00) {
+        sAppStatus.u8ReadAddr = READ_ADDR_NONE;
+        return;
+    }
+    // 先読みデータの保持
+    sAppStatus.u8ReadAddr = u8MapAddr;
+    sAppStatus.u8ReadData = psRegion->pu8Data[u8MapAddr - psRegion->u8Base];
+}
+
 /******************************************************************************/
 /***        ISR Functions                                                 ***/
 /******************************************************************************/
@@ -958,7 +1648,7 @@ static uint8 ssp1_u8ReadData() {
  *
  * NAME: __interrupt(high_priority) ISR
  *
- * DESCRIPTION:荞ݏ
+ * DESCRIPTION:割り込み処理
  *
  * PARAMETERS:      Name            RW  Usage
  *
@@ -969,15 +1659,30 @@ static uint8 ssp1_u8ReadData() {
  ******************************************************************************/
 void __interrupt(high_priority) ISR() {
     //==========================================================================
-    // ^C}[荞ݔ̏
+    // SSP(I2C)割り込み発生時の処理（クロックストレッチ時間短縮の為に最優先）
     //==========================================================================
-    // ^C}[荞ݏ
+    I2C_vSlaveIsrSSP1();
+    // SCLラインの開放後に受信データを直接反映する
+    if (sAppStatus.u8DirectAddr != READ_ADDR_NONE) {
+        ssp1_vWriteDirect();
+    }
+    // SCLラインの開放後に次のデータを先読みする
+    if (sAppStatus.bPrefetchReq) {
+        sAppStatus.bPrefetchReq = false;
+        ssp1_vPrefetch();
+    }
+
+    //==========================================================================
+    // タイマー割り込み発生時の処理
+    //==========================================================================
+    // タイマー割り込み処理
     timer_vInterrupt();
     
     //==========================================================================
-    // SSP(I2C)荞ݔ̏
+    // LCDバスの割り込み処理
     //==========================================================================
-    I2C_vSlaveIsrSSP1();
+    // 非同期トランザクション（LCDバス）の処理
+    I2C_vMasterIsrSSP2();
 }
 
 /******************************************************************************/
@@ -33,7 +33,7 @@ extern "C" {
 /***        Macro Definitions                                               ***/
 /******************************************************************************/
 
-// {f[^^̒`
+// 基本データ型の定義
 #define bool   unsigned char
 #define int8   char
 #define int16  int
@@ -42,14 +42,14 @@ extern "C" {
 #define uint16 unsigned int
 #define uint32 unsigned long
 
-// u[l
+// ブール値
 #define true  (1)
 #define false (0) 
 // ON/OFF
 #define ON  (1)
 #define OFF (0) 
 
-    // |[g̎ʎq
+    // ポートの識別子
 #ifdef PORTA
 #define ID_PORTA  (0x0000)
 #endif
@@ -21,69 +21,185 @@
 /***       Include files                                                    ***/
 /******************************************************************************/
 #include <xc.h>
-#include "i2cUtil.h"        // I2C֐Cu[p
-#include "libcom.h"         // ʒ`
-#include "keypad.h"         // L[pbh
+#include "setting.h"        // 設定値
+#include "i2cUtil.h"        // I2C関数ライブラリー用
+#include "libcom.h"         // 共通定義
+#include "keypad.h"         // キーパッド
 
 /******************************************************************************/
 /***       Macro Definitions                                                ***/
 /******************************************************************************/
 
 //==========================================================
-// I2CoX̒`
+// I2Cバス毎の定義
 //==========================================================
-// SSPxSTATR/WAD/AABFASSPxCON2WX^ACKSTAT琶
-#define u8GetSSP1EvtType() ((SSP1STAT & 0b00100101) | (SSP1CON2 & 0b01000000))
-
+// バスの数
 #ifdef SSP2STAT
-// SSPxSTATR/WAD/AABFASSPxCON2WX^ACKSTAT琶
-#define u8GetSSP2EvtType() ((SSP2STAT & 0b00100101) | (SSP2CON2 & 0b01000000))
+#define I2C_BUS_CNT         (2)
+#else
+#define I2C_BUS_CNT         (1)
 #endif
 
+// SSPxSTATのビット
+#define SSP_STAT_BF         (0b00000001)    // バッファフル
+#define SSP_STAT_R_W        (0b00000100)    // 送信中（マスターモード）
+// SSPxCON1のビット
+#define SSP_CON1_CKP        (0b00010000)    // SCL開放
+#define SSP_CON1_SSPEN      (0b00100000)    // MSSP有効
+// SSPxCON2のビット
+#define SSP_CON2_SEN        (0b00000001)    // スタートコンディション
+#define SSP_CON2_RSEN       (0b00000010)    // リスタートコンディション
+#define SSP_CON2_PEN        (0b00000100)    // ストップコンディション
+#define SSP_CON2_RCEN       (0b00001000)    // 受信許可
+#define SSP_CON2_ACKEN      (0b00010000)    // ACK/NACK送信
+#define SSP_CON2_ACKDT      (0b00100000)    // ACKデータ（1:NACK）
+#define SSP_CON2_ACKSTAT    (0b01000000)    // ACK受信状態（1:NACK）
+#define SSP_CON2_BUSY       (0b00011111)    // SEN/RSEN/PEN/RCEN/ACKEN
+
+// バス復旧時のSCLのHigh/Low期間（us）
+#define I2C_RECOVER_WAIT    (5)
+// バス復旧時のSCLのパルス数
+#define I2C_RECOVER_PULSE   (9)
+
+//==========================================================
+// バス番号を定数とする特殊化（SFRを直接参照する）
+//==========================================================
+// SSPxSTATのR/W、D/A、BF、SSPxCON2レジスタのACKSTATから生成
+#define u8GetEvtType(n) ((SSP##n##STAT & 0b00100101) | (SSP##n##CON2 & 0b01000000))
+
+// スレーブ割り込み処理の本体
+// SCLラインの開放はここで行い、コールバック関数で送信データとACKDTを
+// 設定し終えてから開放する（コールバック関数がfalseを返した場合は保持したまま
+// とし、I2C_vSlaveReleaseで開放する）
+// ストップコンディション検出時はSCLを保持していないので開放しない
+#define SLAVE_ISR_BODY(n)                                       \
+    if (SSP##n##IF == 1) {                                      \
+        SSP##n##IF = 0;             /* 割込みフラグクリア */    \
+        if (SSP##n##STATbits.P == 1) {                          \
+            pbSlaveFunc[n - 1](n, I2C_SLV_EVT_STOP);            \
+        } else {                                                \
+            SSP##n##CON2bits.ACKDT = 0x00;                      \
+            if (pbSlaveFunc[n - 1](n, u8GetEvtType(n))) {       \
+                SSP##n##CON1bits.CKP = 1; /* SCLライン開放 */   \
+            }                                                   \
+        }                                                       \
+    }                                                           \
+    if (BCL##n##IF == 1) {                                      \
+        pbSlaveFunc[n - 1](n, I2C_SLV_EVT_BUS_ERROR);           \
+        BCL##n##IF = 0;             /* フラグクリア */          \
+    }
+
 /******************************************************************************/
 /***        Type Definitions                                                ***/
 /******************************************************************************/
+/**
+ * 非同期トランザクションの処理ステップ
+ */
+typedef enum {
+    MST_STEP_IDLE = 0,      // 待機中
+    MST_STEP_WAIT,          // 直前の処理（ストップコンディション等）の完了待ち
+    MST_STEP_START,         // スタートコンディション送信中
+    MST_STEP_TX,            // アドレス/データ送信中
+    MST_STEP_RESTART,       // リスタートコンディション送信中
+    MST_STEP_RX_ADDR,       // 読み込みアドレス送信中
+    MST_STEP_RX,            // データ受信中
+    MST_STEP_RX_ACK,        // ACK/NACK送信中
+    MST_STEP_STOP           // ストップコンディション送信中
+} teMstStep;
 
 /******************************************************************************/
 /***        Local Function Prototypes                                       ***/
 /******************************************************************************/
-/** I2C̃}X^[̃EFCg */
-static void vMasterWaitSSP1();
+/** I2Cのマスターのウェイト処理 */
+static bool bMasterWait(const tsI2C_Bus *psBus);
+
+/** I2CマスターのACK判定 */
+static uint8 u8MasterAck(const tsI2C_Bus *psBus);
+
+/** I2Cのバス復旧処理 */
+static void vRecover(const tsI2C_Bus *psBus);
+
+/** I2Cのスレーブのウェイト処理 */
+static void vSlaveWait(const tsI2C_Bus *psBus);
 
 #ifdef SSP2STAT
-/** I2C̃}X^[̃EFCg */
-static void vMasterWaitSSP2();
+/** 非同期トランザクションの開始処理 */
+static void vMstBeginSSP2();
 #endif
 
-/** I2C̃}X^[̃EFCg */
-static void vSlaveWaitSSP1();
+#ifdef SSP2STAT
+/** 非同期トランザクションのストップ処理 */
+static void vMstStopSSP2(uint8 u8Status);
+#endif
+
+#ifdef SSP2STAT
+/** 非同期トランザクションの完了処理 */
+static void vMstFinishSSP2();
+#endif
 
 #ifdef SSP2STAT
-/** I2C̃}X^[̃EFCg */
-static void vSlaveWaitSSP2();
+/** 非同期トランザクションの完了待ち */
+static void vMstDrainSSP2();
 #endif
 
-/** R[obN֐̃_~[ */
-static void vDmyCallback(uint8 u8BusNo, uint8 u8EvtType);
+#ifdef SSP2STAT
+/** 非同期トランザクションの中断処理 */
+static void vMstAbortSSP2();
+#endif
+
+/** コールバック関数のダミー */
+static bool bDmyCallback(uint8 u8BusNo, uint8 u8EvtType);
 
 
 /******************************************************************************/
 /***        Exported Variables                                              ***/
 /******************************************************************************/
+/** SSP1のバス記述子 */
+const tsI2C_Bus I2C_sBusSSP1 = {
+    1, &SSP1BUF, &SSP1STAT, &SSP1CON1, &SSP1CON2, &SSP1CON3, &SSP1ADD, &SSP1MSK,
+    &PIR1, &PIE1, _PIR1_SSP1IF_MASK, &PIR2, &PIE2, _PIR2_BCL1IF_MASK,
+    &TRISB, &LATB, 0b00010000, 0b00000010       // SCL1:RB4、SDA1:RB1
+};
+#ifdef SSP2STAT
+/** SSP2のバス記述子 */
+const tsI2C_Bus I2C_sBusSSP2 = {
+    2, &SSP2BUF, &SSP2STAT, &SSP2CON1, &SSP2CON2, &SSP2CON3, &SSP2ADD, &SSP2MSK,
+    &PIR4, &PIE4, _PIR4_SSP2IF_MASK, &PIR4, &PIE4, _PIR4_BCL2IF_MASK,
+    &TRISB, &LATB, 0b00100000, 0b00000100       // SCL2:RB5、SDA2:RB2
+};
+#endif
 
 /******************************************************************************/
 /***        Local Variables                                                 ***/
 /******************************************************************************/
-// X^[gtO
-static bool bMstStartFlgSSP1 = false;
+// スタートフラグ（バス番号 - 1で参照）
+static bool bMstStartFlg[I2C_BUS_CNT];
+// タイムアウト又はバス衝突による中断フラグ（バス番号 - 1で参照）
+static bool bMstAbortFlg[I2C_BUS_CNT];
+// NACK受信、タイムアウト又はバス衝突の発生フラグ（バス番号 - 1で参照）
+static bool bMstErrorFlg[I2C_BUS_CNT];
+
+// コールバック関数のポインタ（バス番号 - 1で参照）
+static bool (*pbSlaveFunc[I2C_BUS_CNT])(uint8 u8BusNo, uint8 u8EvtType) = {
+    bDmyCallback
 #ifdef SSP2STAT
-static bool bMstStartFlgSSP2 = false;
+   ,bDmyCallback
 #endif
+};
 
-// R[obN֐̃|C^
-static void (*pvSSP1Func)(uint8 u8BusNo, uint8 u8EvtType) = vDmyCallback;
+// 非同期トランザクションキュー
 #ifdef SSP2STAT
-static void (*pvSSP2Func)(uint8 u8BusNo, uint8 u8EvtType) = vDmyCallback;
+static tsI2C_MstTrans *psMstQueueSSP2[I2C_MST_QUEUE_SIZE];
+static volatile uint8 u8MstQueueBeginSSP2 = 0;
+static volatile uint8 u8MstQueueSizeSSP2  = 0;
+// 非同期トランザクションの処理ステップ
+static teMstStep eMstStepSSP2 = MST_STEP_IDLE;
+// 送受信データのインデックス
+static uint8 u8MstIdxSSP2;
+// 非同期トランザクションの処理結果
+static uint8 u8MstResultSSP2;
+// 非同期トランザクションの進捗カウンタ（割り込み毎に更新）
+static volatile uint8 u8MstProgressSSP2 = 0;
 #endif
 
 /******************************************************************************/
@@ -91,453 +207,545 @@ static void (*pvSSP2Func)(uint8 u8BusNo, uint8 u8EvtType) = vDmyCallback;
 /******************************************************************************/
 /*******************************************************************************
  *
- * NAME: I2C_vInitMasterSSP1
+ * NAME: I2C_vInitMaster
  *
- * DESCRIPTION:w肳ꂽI2C[hŏ
+ * DESCRIPTION:指定されたI2Cモードで初期化する
  *
  * PARAMETERS:    Name      RW  Usage
- * I2C_MasterMode eMode     R   }X^[[h
- *      uint8     u8ClkDiv  R   NbNl
+ * tsI2C_Bus*     psBus     R   バス記述子
+ * I2C_MasterMode eMode     R   マスターモード
+ *      uint8     u8ClkDiv  R   クロック分割値
  *
  * RETURNS:
  *
  * NOTES:
- *   }X^ݒ莞̃NbNliu8ClkDivj̗
+ *   マスタ設定時のクロック分割値（u8ClkDiv）はI2C_CLK_DIVで算出する
  *     Baud Rate = (_XTAL_FREQ / (4 * (u8ClkDiv + 1)))
- *     100Kbps |  4MHz(_XTAL_FREQ= 4000000) | u8AddReg=0x09
- *     100Kbps |  8MHz(_XTAL_FREQ= 8000000) | u8AddReg=0x13
- *     100Kbps | 16MHz(_XTAL_FREQ=16000000) | u8AddReg=0x27
- *     100Kbps | 32MHz(_XTAL_FREQ=32000000) | u8AddReg=0x4F
- *     400Kbps |  8MHz(_XTAL_FREQ= 8000000) | u8AddReg=0x04
- *     400Kbps | 16MHz(_XTAL_FREQ=16000000) | u8AddReg=0x09
- *     400Kbps | 32MHz(_XTAL_FREQ=32000000) | u8AddReg=0x13
+ *     例：I2C_CLK_DIV(I2C_BAUD_STD)       100Kbps | 16MHz | 0x27
+ *         I2C_CLK_DIV(I2C_BAUD_HIGH)      400Kbps | 16MHz | 0x09
+ *         I2C_CLK_DIV(I2C_BAUD_FAST_PLUS)   1Mbps | 16MHz | 0x03
+ *   ウェイト処理のタイムアウト計測の為にTimer1を動作させる。
+ *   SSP2はバス衝突割り込みを許可し、I2C_vMasterIsrSSP2で処理する。
  * 
  ******************************************************************************/
-extern void I2C_vInitMasterSSP1(enum I2C_MasterMode eMode, uint8 u8ClkDiv) {
-    // X^[gtOiSSP1j̏
-    bMstStartFlgSSP1 = false;
-    // SDA/SCLs7bitAhXI2CŎgpA}X^[[hƂ
-    if (eMode == I2C_MASTER_STD) {
-        // W[hɐݒ肷(100kHz)
-        SSP1STAT= 0b10000000;
+extern void I2C_vInitMaster(const tsI2C_Bus *psBus,
+                            enum I2C_MasterMode eMode, uint8 u8ClkDiv) {
+    // スタートフラグの初期化
+    bMstStartFlg[psBus->u8BusNo - 1] = false;
+    // タイムアウト計測用のタイマー
+    timer1_vInit();
+    // SDA/SCLピンは7bitアドレスのI2Cで使用し、マスターモードとする
+    if (eMode == I2C_MASTER_HIGH) {
+        // 高速モードに設定する(400kHz)、スルーレート制御有効
+        *psBus->pu8Stat = 0b00000000;
     } else {
-        // [hɐݒ肷(400kHz)
-        SSP1STAT= 0b00000000;
+        // 標準モード(100kHz)又はFast-mode Plus(1MHz)に設定する、スルーレート制御無効
+        *psBus->pu8Stat = 0b10000000;
     }
     // Baud Rate=(_XTAL_FREQ / (4 * (SSPxADD + 1)));
-    SSP1ADD = u8ClkDiv;
-    // SDA/SCLs7bitAhXI2CŎgpA}X^[[hƂ
-    SSP1CON1 = 0b00101000;
-    SSP1CON2 = 0b10000000;
+    *psBus->pu8Add = u8ClkDiv;
+    // SDA/SCLピンは7bitアドレスのI2Cで使用し、マスターモードとする
+    *psBus->pu8Con1 = 0b00101000;
+    *psBus->pu8Con2 = 0b10000000;
+#ifdef SSP2STAT
+    // バス衝突割り込みの処理はSSP2のみ（I2C_vMasterIsrSSP2）
+    if (psBus == I2C_BUS_SSP2) {
+        *psBus->pu8BclIF &= ~psBus->u8BclMask;  // MSSP(I2C)バス衝突割り込みフラグをクリアする
+        *psBus->pu8BclIE |= psBus->u8BclMask;   // MSSP(I2C)バス衝突割り込みを許可する
+    }
+#endif
 }
 
 /*******************************************************************************
  *
- * NAME: I2C_vInitMasterSSP2
+ * NAME: I2C_vInitSlave
  *
- * DESCRIPTION:w肳ꂽI2C[hŏ
+ * DESCRIPTION:指定されたI2Cスレーブモードで初期化する
  *
- * PARAMETERS:    Name      RW  Usage
- * I2C_MasterMode eMode     R   }X^[[h
- *      uint8     u8ClkDiv  R   NbNl
+ * PARAMETERS:   Name         RW  Usage
+ * tsI2C_Bus*    psBus        R   バス記述子
+ *      uint8    u8Address    R   I2Cアドレス
+ * I2C_SlaveMode eMode        R   スレーブモード
+ *      bool     (*pbCallback)(uint8 u8BusNo, uint8 u8EvtType)
  *
  * RETURNS:
  *
  * NOTES:
- *   }X^ݒ莞̃NbNliu8ClkDivj̗
- *     Baud Rate = (_XTAL_FREQ / (4 * (u8ClkDiv + 1)))
- *     100Kbps |  4MHz(_XTAL_FREQ= 4000000) | u8AddReg=0x09
- *     100Kbps |  8MHz(_XTAL_FREQ= 8000000) | u8AddReg=0x13
- *     100Kbps | 16MHz(_XTAL_FREQ=16000000) | u8AddReg=0x27
- *     100Kbps | 32MHz(_XTAL_FREQ=32000000) | u8AddReg=0x4F
- *     400Kbps |  8MHz(_XTAL_FREQ= 8000000) | u8AddReg=0x04
- *     400Kbps | 16MHz(_XTAL_FREQ=16000000) | u8AddReg=0x09
- *     400Kbps | 32MHz(_XTAL_FREQ=32000000) | u8AddReg=0x13
- * 
+ * コールバック関数がtrueを返した場合、復帰後にSCLラインを開放する。
+ * コールバック関数内ではCKPを操作せず、復帰までに送信データとACKDTを
+ * 設定すること。falseを返した場合はSCLラインを保持したままとし、処理の
+ * 準備ができた時点でI2C_vSlaveReleaseを呼び出して開放する。
+ * トランザクションの終了はI2C_SLV_EVT_STOPで通知する。
  ******************************************************************************/
-extern void I2C_vInitMasterSSP2(enum I2C_MasterMode eMode, uint8 u8ClkDiv) {
-    // X^[gtOiSSP2j̏
-    bMstStartFlgSSP2 = false;
-    // SDA/SCLs7bitAhXI2CŎgpA}X^[[hƂ
-    if (eMode == I2C_MASTER_STD) {
-        // W[hɐݒ肷(100kHz)
-        SSP2STAT= 0b10000000;
+extern void I2C_vInitSlave(const tsI2C_Bus *psBus, uint8 u8Address,
+                            enum I2C_SlaveMode eMode,
+                            bool (*pbCallback)(uint8 u8BusNo, uint8 u8EvtType)) {
+    // コールバック関数の設定
+    if (pbCallback != NULL) {
+        pbSlaveFunc[psBus->u8BusNo - 1] = pbCallback;
+    }
+    // 通信速度の設定
+    if (eMode == I2C_SLAVE_STD) {
+        // 標準モードに設定する(100kHz)
+        *psBus->pu8Stat = 0b10000000;
     } else {
-        // [hɐݒ肷(400kHz)
-        SSP2STAT= 0b00000000;
+        // 高速モードに設定する(400kHz)
+        *psBus->pu8Stat = 0b00000000;
     }
-    // Baud Rate=(_XTAL_FREQ / (4 * (SSPxADD + 1)));
-    SSP2ADD = u8ClkDiv;
-    // SDA/SCLs7bitAhXI2CŎgpA}X^[[hƂ
-    SSP2CON1 = 0b00101000;
-    SSP2CON2 = 0b10000000;
+    // SDA/SCLピンは7bitアドレスのI2Cで使用し、スレーブモードとする
+    *psBus->pu8Con1 = 0b00110110;
+    // 一括呼び出しの同報通知を有効にする
+    // SCL制御(クロックストレッチ)を行う
+    *psBus->pu8Con2 = 0b10000001;
+    // ストップコンディション割り込みとバス衝突割り込みを有効化
+    *psBus->pu8Con3 = 0b01000101;
+    *psBus->pu8Add  = u8Address << 1;           // マイアドレスの設定
+    *psBus->pu8Msk  = 0b11111110;               // アドレス比較時のマスクデータ
+    *psBus->pu8SspIF &= ~psBus->u8SspMask;      // SSP(I2C)割り込みフラグをクリアする
+    *psBus->pu8BclIF &= ~psBus->u8BclMask;      // MSSP(I2C)バス衝突割り込みフラグをクリアする
+    *psBus->pu8SspIE |= psBus->u8SspMask;       // SSP(I2C)割り込みを許可する
+    *psBus->pu8BclIE |= psBus->u8BclMask;       // MSSP(I2C)バス衝突割り込みを許可する
 }
 
 /*******************************************************************************
  *
- * NAME: I2C_vInitSlaveSSP1
+ * NAME: I2C_u8MstStart
  *
- * DESCRIPTION:SSP1w肳ꂽI2CX[u[hŏ
+ * DESCRIPTION:I2Cのマスターのスタート処理
  *
- * PARAMETERS:   Name         RW  Usage
- *      uint8    u8Address    R   I2CAhX
- * I2C_SlaveMode eMode        R   X[u[h
- *      void     (*pvCallback)(uint8 u8BusNo, uint8 u8EvtType)
+ * PARAMETERS:  Name            RW  Usage
+ *  tsI2C_Bus*  psBus           R   バス記述子
+ *       uint8  u8Address       R   I2Cアドレス
+ *        bool  bReadFlg        R   読み込みフラグ
  *
  * RETURNS:
+ *    uint8 処理結果（I2C_MstResult）
  *
  * NOTES:
- * 
+ * SSP2に非同期トランザクションが登録されている場合には完了まで待機する。
+ * 直前のトランザクションのタイムアウトによる中断状態を解除する。
  ******************************************************************************/
-extern void I2C_vInitSlaveSSP1(uint8 u8Address, enum I2C_SlaveMode eMode,
-                            void (*pvCallback)(uint8 u8BusNo, uint8 u8EvtType)) {
-    // R[obN֐̐ݒ
-    if (pvCallback != NULL) {
-        pvSSP1Func = pvCallback;
+extern uint8 I2C_u8MstStart(const tsI2C_Bus *psBus, uint8 u8Address, bool bReadFlg) {
+    uint8 u8Idx = psBus->u8BusNo - 1;
+#ifdef SSP2STAT
+    // 非同期トランザクションの完了待ち
+    if (psBus == I2C_BUS_SSP2) {
+        vMstDrainSSP2();
     }
-    // ʐMx̐ݒ
-    if (eMode == I2C_SLAVE_STD) {
-        // W[hɐݒ肷(100kHz)
-        SSP1STAT = 0b10000000;
+#endif
+    // 中断状態の解除
+    bMstAbortFlg[u8Idx] = false;
+    // スタート状態の判定
+    if (!bMasterWait(psBus)) {
+        return I2C_MST_TIMEOUT;
+    }
+    if (bMstStartFlg[u8Idx] == true) {
+        *psBus->pu8Con2 |= SSP_CON2_RSEN;
     } else {
-        // [hɐݒ肷(400kHz)
-        SSP1STAT = 0b00000000;
-    }
-    // SDA/SCLs7bitAhXI2CŎgpAX[u[hƂ
-    SSP1CON1 = 0b00110110;
-    // ꊇĂяo̓ʒmLɂ
-    // SCL(NbNXgb`)s
-    SSP1CON2 = 0b10000001;
-    // oXՓˊ荞݂L
-    SSP1CON3 = 0b00000101;
-    SSP1ADD  = u8Address << 1;  // }CAhX̐ݒ
-    SSP1MSK  = 0b11111110;      // AhXr̃}XNf[^
-    SSP1IF   = 0;               // SSP(I2C)荞݃tONA
-    BCL1IF   = 0;               // MSSP(I2C)oXՓˊ荞݃tONA
-    SSP1IE   = 1;               // SSP(I2C)荞݂
-    BCL1IE   = 1;               // MSSP(I2C)oXՓˊ荞݂
+        bMstStartFlg[u8Idx] = true;
+        *psBus->pu8Con2 |= SSP_CON2_SEN;
+    }
+    if (!bMasterWait(psBus)) {
+        return I2C_MST_TIMEOUT;
+    }
+    *psBus->pu8Buf = (u8Address << 1) | (bReadFlg & 0x01);
+    if (!bMasterWait(psBus)) {
+        return I2C_MST_TIMEOUT;
+    }
+    return u8MasterAck(psBus);
 }
 
 /*******************************************************************************
  *
- * NAME: I2C_vInitSlaveSSP2
+ * NAME: I2C_vMstStop
  *
- * DESCRIPTION:SSP2w肳ꂽI2CX[u[hŏ
+ * DESCRIPTION:I2Cのマスターのストップ処理
  *
- * PARAMETERS:   Name         RW  Usage
- *      uint8    u8Address    R   I2CAhX
- * I2C_SlaveMode eMode        R   X[u[h
- *      void     (*pvCallback)(uint8 u8BusNo, uint8 u8EvtType)
+ * PARAMETERS:  Name            RW  Usage
+ *  tsI2C_Bus*  psBus           R   バス記述子
  *
  * RETURNS:
  *
  * NOTES:
- * 
+ * タイムアウトで中断中の場合は、復旧処理でストップコンディションを送信済み
  ******************************************************************************/
-#ifdef SSP2STAT
-extern void I2C_vInitSlaveSSP2(uint8 u8Address, enum I2C_SlaveMode eMode,
-                            void (*pvCallback)(uint8 u8BusNo, uint8 u8EvtType)) {
-    // R[obN֐̐ݒ
-    if (pvCallback != NULL) {
-        pvSSP2Func = pvCallback;
+extern void I2C_vMstStop(const tsI2C_Bus *psBus) {
+    if (bMstAbortFlg[psBus->u8BusNo - 1]) {
+        return;
     }
-    // ʐMx̐ݒ
-    if (eMode == I2C_SLAVE_STD) {
-        // W[hɐݒ肷(100kHz)
-        SSP2STAT = 0b10000000;
-    } else {
-        // [hɐݒ肷(400kHz)
-        SSP2STAT = 0b00000000;
-    }
-    // SDA/SCLs7bitAhXI2CŎgpAX[u[hƂ
-    SSP2CON1 = 0b00110110;
-    // ꊇĂяo̓ʒmLɂ
-    // SCL(NbNXgb`)s
-    SSP2CON2 = 0b10000001;
-    // oXՓˊ荞݂L
-    SSP2CON3 = 0b00000101;
-    SSP2ADD  = u8Address << 1;  // }CAhX̐ݒ
-    SSP2MSK  = 0b11111110;      // AhXr̃}XNf[^
-    SSP2IF   = 0;               // SSP(I2C)荞݃tONA
-    BCL2IF   = 0;               // MSSP(I2C)oXՓˊ荞݃tONA
-    SSP2IE   = 1;               // SSP(I2C)荞݂
-    BCL2IE   = 1;               // MSSP(I2C)oXՓˊ荞݂
+    if (!bMasterWait(psBus)) {
+        return;
+    }
+    bMstStartFlg[psBus->u8BusNo - 1] = false;
+    *psBus->pu8Con2 |= SSP_CON2_PEN;
 }
-#endif
 
 /*******************************************************************************
  *
- * NAME: I2C_u8MstStartSSP1
+ * NAME: I2C_u8MstTx
  *
- * DESCRIPTION:I2C̃}X^[̃X^[g
+ * DESCRIPTION:I2Cのマスターの送信処理
  *
  * PARAMETERS:  Name            RW  Usage
- *       uint8  u8Address       R   I2CAhX
- *        bool  bReadFlg        R   ǂݍ݃tO
+ *  tsI2C_Bus*  psBus           R   バス記述子
+ *       uint8  u8Data          R   送信データ
  *
  * RETURNS:
- *    uint8 ACKSTAT
+ *    uint8 処理結果（I2C_MstResult）
  *
  * NOTES:
- * None.
+ * タイムアウトで中断中の場合は待たずにI2C_MST_TIMEOUTを返す
  ******************************************************************************/
-extern uint8 I2C_u8MstStartSSP1(uint8 u8Address, bool bReadFlg) {
-    // X^[gԂ̔
-    vMasterWaitSSP1();
-    if (bMstStartFlgSSP1 == true) {
-        SSP1CON2bits.RSEN = 1;
-    } else {
-        bMstStartFlgSSP1 = true;
-        SSP1CON2bits.SEN = 1;
+extern uint8 I2C_u8MstTx(const tsI2C_Bus *psBus, uint8 u8Data) {
+    if (bMstAbortFlg[psBus->u8BusNo - 1]) {
+        return I2C_MST_TIMEOUT;
     }
-    vMasterWaitSSP1();
-    SSP1BUF = (u8Address << 1) | (bReadFlg & 0x01);
-    vMasterWaitSSP1();
-    return SSP1CON2bits.ACKSTAT;
+    *psBus->pu8Buf = u8Data;
+    if (!bMasterWait(psBus)) {
+        return I2C_MST_TIMEOUT;
+    }
+    return u8MasterAck(psBus);
 }
 
 /*******************************************************************************
  *
- * NAME: I2C_u8MstStartSSP2
+ * NAME: I2C_u8MstRx
  *
- * DESCRIPTION:I2C̃}X^[̃X^[g
+ * DESCRIPTION:I2Cのマスターの受信処理
  *
- * PARAMETERS:  Name            RW  Usage
- *       uint8  u8Address       R   I2CAhX
- *        bool  bReadFlg        R   ǂݍ݃tO
+ * PARAMETERS:  Name          RW  Usage
+ *  tsI2C_Bus*  psBus         R   バス記述子
+ *        bool  bNackFlg      R   NACK返信フラグ
  *
  * RETURNS:
- *    uint8 ACKSTAT
+ *    uint8 受信データ
  *
  * NOTES:
- * None.
+ * タイムアウトで中断中の場合は0xFFを返す（I2C_bMstErrorで判定する）
  ******************************************************************************/
-#ifdef SSP2STAT
-extern uint8 I2C_u8MstStartSSP2(uint8 u8Address, bool bReadFlg) {
-    // X^[gԂ̔
-    vMasterWaitSSP2();
-    if (bMstStartFlgSSP2 == true) {
-        SSP2CON2bits.RSEN = 1;
+extern uint8 I2C_u8MstRx(const tsI2C_Bus *psBus, bool bNackFlg) {
+    if (bMstAbortFlg[psBus->u8BusNo - 1]) {
+        return 0xFF;
+    }
+    // 受信許可
+    if (!bMasterWait(psBus)) {
+        return 0xFF;
+    }
+    *psBus->pu8Con2 |= SSP_CON2_RCEN;
+    // 受信データ取り込み
+    if (!bMasterWait(psBus)) {
+        return 0xFF;
+    }
+    uint8 u8Data = *psBus->pu8Buf;
+    // ACK/NACK返信する
+    if (!bMasterWait(psBus)) {
+        return 0xFF;
+    }
+    if (bNackFlg) {
+        *psBus->pu8Con2 |= SSP_CON2_ACKDT;
     } else {
-        bMstStartFlgSSP2 = true;
-        SSP2CON2bits.SEN = 1;
+        *psBus->pu8Con2 &= ~SSP_CON2_ACKDT;
     }
-    vMasterWaitSSP2();
-    SSP2BUF = (u8Address << 1) | (bReadFlg & 0x01);
-    vMasterWaitSSP2();
-    return SSP2CON2bits.ACKSTAT;
+    *psBus->pu8Con2 |= SSP_CON2_ACKEN;
+    return u8Data;
 }
-#endif
 
 /*******************************************************************************
  *
- * NAME: I2C_vMstStopSSP1
+ * NAME: I2C_bMstError
  *
- * DESCRIPTION:I2C̃}X^[̃Xgbv
+ * DESCRIPTION:I2Cのマスターのエラー判定
  *
  * PARAMETERS:  Name            RW  Usage
+ *  tsI2C_Bus*  psBus           R   バス記述子
  *
  * RETURNS:
+ *    bool true:前回の判定以降にNACK受信、タイムアウト（バス復旧）又は
+ *              バス衝突が発生した
  *
  * NOTES:
- * None.
+ * 判定後にエラーの発生フラグをクリアする。
+ * スレーブの状態を記憶しているドライバは、エラー発生時に記憶を破棄する事。
  ******************************************************************************/
-extern void I2C_vMstStopSSP1() {
-    vMasterWaitSSP1();
-    bMstStartFlgSSP1 = false;
-    SSP1CON2bits.PEN = 0x01;    
+extern bool I2C_bMstError(const tsI2C_Bus *psBus) {
+    uint8 u8Idx = psBus->u8BusNo - 1;
+    bool bError = bMstErrorFlg[u8Idx];
+    bMstErrorFlg[u8Idx] = false;
+    return bError;
 }
 
 /*******************************************************************************
  *
- * NAME: I2C_vMstStopSSP2
+ * NAME: I2C_bMstSubmitSSP2
  *
- * DESCRIPTION:I2C̃}X^[̃Xgbv
+ * DESCRIPTION:I2Cマスターの非同期トランザクション登録
  *
- * PARAMETERS:  Name            RW  Usage
+ * PARAMETERS:      Name            RW  Usage
+ * tsI2C_MstTrans*  psTrans         RW  トランザクション記述子
  *
  * RETURNS:
+ *    bool true:登録成功、false:キューが一杯
  *
  * NOTES:
- * None.
+ * 登録されたトランザクションはSSP2IFの割り込みで順次実行され、
+ * 完了時に記述子の状態を更新してコールバック関数を呼び出す。
+ * 割り込み許可状態を保存するクリティカルセクションで登録する為、完了通知の
+ * コールバック関数（割り込み内）から次のトランザクションを登録してもよい。
+ * スタート～ストップ処理の途中（同期処理でのバス占有中）には登録しない事。
  ******************************************************************************/
 #ifdef SSP2STAT
-/** I2C̃}X^[̃Xgbv */
-extern void I2C_vMstStopSSP2() {
-    vMasterWaitSSP2();
-    bMstStartFlgSSP2 = false;
-    SSP2CON2bits.PEN = 0x01;
+extern bool I2C_bMstSubmitSSP2(tsI2C_MstTrans *psTrans) {
+    // キューの空き判定
+    if (u8MstQueueSizeSSP2 >= I2C_MST_QUEUE_SIZE) {
+        return false;
+    }
+    // クリティカルセクション開始
+    criticalSec_vBegin();
+    // キューへの登録
+    psTrans->u8Status = I2C_TRANS_QUEUED;
+    uint8 u8Idx = (u8MstQueueBeginSSP2 + u8MstQueueSizeSSP2) % I2C_MST_QUEUE_SIZE;
+    psMstQueueSSP2[u8Idx] = psTrans;
+    u8MstQueueSizeSSP2++;
+    // 待機中の場合にはトランザクションを開始する
+    if (eMstStepSSP2 == MST_STEP_IDLE) {
+        vMstBeginSSP2();
+    }
+    // クリティカルセクション終了
+    criticalSec_vEnd();
+    return true;
 }
 #endif
 
 /*******************************************************************************
  *
- * NAME: I2C_u8MstTxSSP1
+ * NAME: I2C_bMstBusySSP2
  *
- * DESCRIPTION:I2C̃}X^[̑M
+ * DESCRIPTION:I2Cマスターの非同期トランザクション実行中判定
  *
- * PARAMETERS:  Name            RW  Usage
- *       uint8  u8Data          R   Mf[^
+ * PARAMETERS:      Name            RW  Usage
  *
  * RETURNS:
- *    uint8 ACKSTAT
+ *    bool true:実行中または実行待ちのトランザクション有り
  *
  * NOTES:
  * None.
  ******************************************************************************/
-extern uint8 I2C_u8MstTxSSP1(uint8 u8Data) {
-    SSP1BUF = u8Data;
-    vMasterWaitSSP1();
-    return SSP1CON2bits.ACKSTAT;
+#ifdef SSP2STAT
+extern bool I2C_bMstBusySSP2() {
+    return (u8MstQueueSizeSSP2 > 0);
 }
+#endif
 
 /*******************************************************************************
  *
- * NAME: I2C_u8MstTxSSP2
+ * NAME: I2C_vMstDrainSSP2
  *
- * DESCRIPTION:I2C̃}X^[̑M
+ * DESCRIPTION:I2Cマスターの非同期トランザクション完了待ち
  *
- * PARAMETERS:  Name            RW  Usage
- *       uint8  u8Data          R   Mf[^
+ * PARAMETERS:      Name            RW  Usage
  *
  * RETURNS:
- *    uint8 ACKSTAT
  *
  * NOTES:
- * None.
+ * 完了通知から登録された後続のトランザクションも含めて、キューが空になるまで
+ * 待機する。主処理から呼び出す事。
  ******************************************************************************/
 #ifdef SSP2STAT
-/** I2C̃}X^[̑M */
-extern uint8 I2C_u8MstTxSSP2(uint8 u8Data) {
-    SSP2BUF = u8Data;
-    vMasterWaitSSP2();
-    return SSP2CON2bits.ACKSTAT;
+extern void I2C_vMstDrainSSP2() {
+    vMstDrainSSP2();
 }
 #endif
 
 /*******************************************************************************
  *
- * NAME: I2C_u8MstRxSSP1
+ * NAME: I2C_vSlaveRelease
  *
- * DESCRIPTION:I2C̃}X^[̎M
+ * DESCRIPTION:I2Cスレーブの保持しているSCLラインを開放する
  *
- * PARAMETERS:  Name          RW  Usage
- *        bool  bNackFlg      R   NACKԐMtO
+ * PARAMETERS:   Name         RW  Usage
+ * tsI2C_Bus*    psBus        R   バス記述子
  *
  * RETURNS:
- *    uint8 Mf[^
  *
  * NOTES:
- * None.
+ * スレーブのコールバック関数がfalseを返して保持したSCLラインを開放する。
+ * ACKDTはコールバック関数の呼び出し時に設定済みの値で応答する。
  ******************************************************************************/
-extern uint8 I2C_u8MstRxSSP1(bool bNackFlg) {
-    // M
-    vMasterWaitSSP1();
-    SSP1CON2bits.RCEN = 1;
-    // Mf[^荞
-    vMasterWaitSSP1();
-    uint8 u8Data = SSP1BUF;
-    // ACK/NACKԐM
-    vMasterWaitSSP1();
-    SSP1CON2bits.ACKDT = bNackFlg & 0x01;
-    SSP1CON2bits.ACKEN = 1;
-    return u8Data;
+extern void I2C_vSlaveRelease(const tsI2C_Bus *psBus) {
+    *psBus->pu8Con1 = *psBus->pu8Con1 | SSP_CON1_CKP;
 }
 
-
 /*******************************************************************************
  *
- * NAME: I2C_u8MstRxSSP2
+ * NAME: I2C_vSlaveIsrSSP1
  *
- * DESCRIPTION:I2C̃}X^[̎M
+ * DESCRIPTION:I2Cスレーブの割り込み処理
  *
  * PARAMETERS:  Name            RW  Usage
- *        bool  bNackFlg        R   NACKԐMtO
  *
  * RETURNS:
- *    uint8 Mf[^
  *
  * NOTES:
- * None.
+ * 割り込み毎に実行される為、バス記述子を経由せずにSFRを直接参照する。
  ******************************************************************************/
-#ifdef SSP2STAT
-extern uint8 I2C_u8MstRxSSP2(bool bNackFlg) {
-    // M
-    vMasterWaitSSP2();
-    SSP2CON2bits.RCEN = 1;
-    // Mf[^荞
-    vMasterWaitSSP2();
-    uint8 u8Data = SSP2BUF;
-    // ACK/NACKԐM
-    vMasterWaitSSP2();
-    SSP2CON2bits.ACKDT = bNackFlg & 0x01;
-    SSP2CON2bits.ACKEN = 1;
-    return u8Data;
+extern void I2C_vSlaveIsrSSP1() {
+    // SSP(I2C)割り込みとMSSP(I2C)バス衝突割り込み発生時の処理
+    SLAVE_ISR_BODY(1)
 }
-#endif
 
 /*******************************************************************************
  *
- * NAME: I2C_vSlaveIsrSSP1
+ * NAME: I2C_vSlaveIsrSSP2
  *
- * DESCRIPTION:I2CX[ů荞ݏ
+ * DESCRIPTION:I2Cスレーブの割り込み処理
  *
  * PARAMETERS:  Name            RW  Usage
  *
  * RETURNS:
  *
  * NOTES:
- * None.
+ * 割り込み毎に実行される為、バス記述子を経由せずにSFRを直接参照する。
  ******************************************************************************/
-extern void I2C_vSlaveIsrSSP1() {
-    //==========================================================================
-    // SSP(I2C)荞ݔ̏
-    //==========================================================================
-    // SSP̊荞݂̗L𔻒
-    if (SSP1IF == 1) {
-        SSP1CON2bits.ACKDT = 0x00;
-        pvSSP1Func(1, u8GetSSP1EvtType());
-        SSP1IF = 0;             // ݃tONA
-        SSP1CON1bits.CKP = 1;   // SCLCJ(ʐM̍ĊJ)
-    }
-    // MSSP(I2C)oXՓˊ荞̏
-    if (BCL1IF == 1) {
-        pvSSP1Func(1, I2C_SLV_EVT_BUS_ERROR);
-        // tONA
-        BCL1IF = 0;
-    }
+#ifdef SSP2STAT
+extern void I2C_vSlaveIsrSSP2() {
+    // SSP(I2C)割り込みとMSSP(I2C)バス衝突割り込み発生時の処理
+    SLAVE_ISR_BODY(2)
 }
+#endif
 
 /*******************************************************************************
  *
- * NAME: I2C_vSlaveIsrSSP2
+ * NAME: I2C_vMasterIsrSSP2
  *
- * DESCRIPTION:I2CX[ů荞ݏ
+ * DESCRIPTION:I2Cマスターの割り込み処理（非同期トランザクション）
  *
  * PARAMETERS:  Name            RW  Usage
  *
  * RETURNS:
  *
  * NOTES:
- * None.
+ * SSP2IEは非同期トランザクションの実行中のみ有効となる。
+ * BCL2IEはI2C_vInitMasterSSP2で常に有効となる為、バス衝突は同期処理の
+ * 実行中も処理する。バス衝突時にはMSSPが待機状態に戻る為、同期処理は
+ * 次のスタートまで中断し、非同期トランザクションはバスエラーで完了とする。
  ******************************************************************************/
 #ifdef SSP2STAT
-extern void I2C_vSlaveIsrSSP2() {
+extern void I2C_vMasterIsrSSP2() {
     //==========================================================================
-    // SSP(I2C)荞ݔ̏
+    // MSSP(I2C)バス衝突発生時の処理
     //==========================================================================
-    // SSP̊荞݂̗L𔻒
-    if (SSP2IF == 1) {
-        SSP2CON2bits.ACKDT = 0x00;
-        pvSSP2Func(2, u8GetSSP2EvtType());
-        SSP2IF = 0;             // ݃tONA
-        SSP2CON1bits.CKP = 1;   // SCLCJ(ʐM̍ĊJ)
-    }
-    // MSSP(I2C)oXՓˊ荞̏
     if (BCL2IF == 1) {
-        pvSSP2Func(2, I2C_SLV_EVT_BUS_ERROR);
-        // tONA
+        // フラグクリア
         BCL2IF = 0;
+        // 次のスタートはリスタートではなくスタートコンディションとする
+        uint8 u8Idx = I2C_BUS_SSP2->u8BusNo - 1;
+        bMstStartFlg[u8Idx] = false;
+        bMstErrorFlg[u8Idx] = true;
+        // 同期処理の中断判定
+        if (SSP2IE == 0) {
+            bMstAbortFlg[u8Idx] = true;
+            return;
+        }
+        // ストップせずに非同期トランザクションを完了とする
+        SSP2IF = 0;
+        u8MstResultSSP2 = I2C_TRANS_BUS_ERROR;
+        vMstFinishSSP2();
+        return;
+    }
+    // 非同期トランザクションの実行中判定
+    if (SSP2IE == 0) {
+        return;
+    }
+    //==========================================================================
+    // SSP(I2C)割り込み発生時の処理
+    //==========================================================================
+    if (SSP2IF == 0) {
+        return;
+    }
+    SSP2IF = 0;             // 割込みフラグクリア
+    u8MstProgressSSP2++;    // 進捗の更新
+    tsI2C_MstTrans *psTrans = psMstQueueSSP2[u8MstQueueBeginSSP2];
+    uint8 u8TxEnd = psTrans->u8TxHeadLen + psTrans->u8TxLen;
+    switch (eMstStepSSP2) {
+        case MST_STEP_WAIT:
+            // 直前の処理の完了：スタートコンディションの送信
+            SSP2CON2bits.SEN = 1;
+            eMstStepSSP2 = MST_STEP_START;
+            break;
+        case MST_STEP_START:
+            // スタートコンディション送信完了：アドレスの送信
+            if (u8TxEnd > 0 || psTrans->u8RxLen == 0) {
+                SSP2BUF = psTrans->u8Address << 1;
+                eMstStepSSP2 = MST_STEP_TX;
+            } else {
+                SSP2BUF = (psTrans->u8Address << 1) | 0x01;
+                eMstStepSSP2 = MST_STEP_RX_ADDR;
+            }
+            break;
+        case MST_STEP_TX:
+            // アドレス/データ送信完了
+            if (SSP2CON2bits.ACKSTAT) {
+                // NACK受信
+                vMstStopSSP2(I2C_TRANS_NACK);
+            } else if (u8MstIdxSSP2 < psTrans->u8TxHeadLen) {
+                // 次のヘッダを送信
+                SSP2BUF = psTrans->pu8TxHead[u8MstIdxSSP2];
+                u8MstIdxSSP2++;
+            } else if (u8MstIdxSSP2 < u8TxEnd) {
+                // 次のデータを送信
+                SSP2BUF = psTrans->pu8TxData[u8MstIdxSSP2 - psTrans->u8TxHeadLen];
+                u8MstIdxSSP2++;
+            } else if (psTrans->u8RxLen > 0) {
+                // 受信の為にリスタート
+                u8MstIdxSSP2 = 0;
+                SSP2CON2bits.RSEN = 1;
+                eMstStepSSP2 = MST_STEP_RESTART;
+            } else {
+                // 送信完了
+                vMstStopSSP2(I2C_TRANS_COMPLETE);
+            }
+            break;
+        case MST_STEP_RESTART:
+            // リスタートコンディション送信完了：読み込みアドレスの送信
+            SSP2BUF = (psTrans->u8Address << 1) | 0x01;
+            eMstStepSSP2 = MST_STEP_RX_ADDR;
+            break;
+        case MST_STEP_RX_ADDR:
+            // 読み込みアドレス送信完了
+            if (SSP2CON2bits.ACKSTAT) {
+                // NACK受信
+                vMstStopSSP2(I2C_TRANS_NACK);
+            } else {
+                // 受信許可
+                SSP2CON2bits.RCEN = 1;
+                eMstStepSSP2 = MST_STEP_RX;
+            }
+            break;
+        case MST_STEP_RX:
+            // データ受信完了：最終データにはNACKを返信する
+            psTrans->pu8RxData[u8MstIdxSSP2] = SSP2BUF;
+            u8MstIdxSSP2++;
+            SSP2CON2bits.ACKDT = (u8MstIdxSSP2 >= psTrans->u8RxLen);
+            SSP2CON2bits.ACKEN = 1;
+            eMstStepSSP2 = MST_STEP_RX_ACK;
+            break;
+        case MST_STEP_RX_ACK:
+            // ACK/NACK送信完了
+            if (u8MstIdxSSP2 < psTrans->u8RxLen) {
+                // 受信許可
+                SSP2CON2bits.RCEN = 1;
+                eMstStepSSP2 = MST_STEP_RX;
+            } else {
+                // 受信完了
+                vMstStopSSP2(I2C_TRANS_COMPLETE);
+            }
+            break;
+        case MST_STEP_STOP:
+            // ストップコンディション送信完了
+            vMstFinishSSP2();
+            break;
+        default:
+            break;
     }
 }
 #endif
@@ -548,93 +756,311 @@ extern void I2C_vSlaveIsrSSP2() {
 
 /*******************************************************************************
  *
- * NAME: vMasterWaitSSP1
+ * NAME: bMasterWait
  *
- * DESCRIPTION:I2C}X^[̃EFCg
+ * DESCRIPTION:I2Cマスターのウェイト処理
  *
  * PARAMETERS:  Name            RW  Usage
+ *  tsI2C_Bus*  psBus           R   バス記述子
  *
  * RETURNS:
+ *    bool true:待機完了、false:タイムアウト
  *
  * NOTES:
- * None.
+ * I2C_WAIT_TIME（us）以内に完了しない場合はバスを復旧し、次のスタートまで
+ * マスターの処理を中断する。経過時間はTimer1で計測する為、クロック周波数に
+ * 依存しない。バスの復旧に時間を要する為、主処理からのみ呼び出す事。
+ ******************************************************************************/
+static bool bMasterWait(const tsI2C_Bus *psBus) {
+    uint16 u16Start = timer1_u16GetTick();
+    do {
+        if ((*psBus->pu8Stat & SSP_STAT_R_W) == 0
+                && (*psBus->pu8Con2 & SSP_CON2_BUSY) == 0) {
+            return true;
+        }
+    } while ((uint16)(timer1_u16GetTick() - u16Start) < TIMER1_TICKS_US(I2C_WAIT_TIME));
+    // バスの復旧
+    vRecover(psBus);
+    bMstAbortFlg[psBus->u8BusNo - 1] = true;
+    bMstErrorFlg[psBus->u8BusNo - 1] = true;
+    return false;
+}
+
+/*******************************************************************************
+ *
+ * NAME: u8MasterAck
+ *
+ * DESCRIPTION:I2CマスターのACK判定
+ *
+ * PARAMETERS:  Name            RW  Usage
+ *  tsI2C_Bus*  psBus           R   バス記述子
+ *
+ * RETURNS:
+ *    uint8 処理結果（I2C_MST_ACK/I2C_MST_NACK）
+ *
+ * NOTES:
+ * NACK受信時はエラーの発生フラグを設定する。
  ******************************************************************************/
-static void vMasterWaitSSP1() {
-    while ((SSP1STAT & 0x04) || (SSP1CON2 & 0x1F));
+static uint8 u8MasterAck(const tsI2C_Bus *psBus) {
+    if ((*psBus->pu8Con2 & SSP_CON2_ACKSTAT) == 0) {
+        return I2C_MST_ACK;
+    }
+    bMstErrorFlg[psBus->u8BusNo - 1] = true;
+    return I2C_MST_NACK;
 }
 
 /*******************************************************************************
  *
- * NAME: vMasterWaitSSP2
+ * NAME: vRecover
  *
- * DESCRIPTION:I2C}X^[̃EFCg
+ * DESCRIPTION:I2Cのバス復旧処理
  *
  * PARAMETERS:  Name            RW  Usage
+ *  tsI2C_Bus*  psBus           R   バス記述子
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * MSSPを停止してSCLを9回パルス出力し、SDAを保持しているスレーブを開放させた後に
+ * ストップコンディションを送信してMSSPを再初期化する。
+ * SCL/SDAはLATを0とし、TRISの切り替えでオープンドレイン出力を模擬する。
+ ******************************************************************************/
+static void vRecover(const tsI2C_Bus *psBus) {
+    uint8 u8Con1 = *psBus->pu8Con1;
+    uint8 u8Pins = psBus->u8SclMask | psBus->u8SdaMask;
+    // MSSPを停止してSCL/SDAを汎用ポートとする
+    *psBus->pu8Con1 = u8Con1 & ~SSP_CON1_SSPEN;
+    *psBus->pu8Lat  &= ~u8Pins;
+    *psBus->pu8Tris |= u8Pins;
+    // SCLのパルス出力
+    uint8 u8Cnt;
+    for (u8Cnt = 0; u8Cnt < I2C_RECOVER_PULSE; u8Cnt++) {
+        *psBus->pu8Tris &= ~psBus->u8SclMask;
+        __delay_us(I2C_RECOVER_WAIT);
+        *psBus->pu8Tris |= psBus->u8SclMask;
+        __delay_us(I2C_RECOVER_WAIT);
+    }
+    // ストップコンディション（SCLがHighの間にSDAをLowからHighにする）
+    *psBus->pu8Tris &= ~psBus->u8SclMask;
+    *psBus->pu8Tris &= ~psBus->u8SdaMask;
+    __delay_us(I2C_RECOVER_WAIT);
+    *psBus->pu8Tris |= psBus->u8SclMask;
+    __delay_us(I2C_RECOVER_WAIT);
+    *psBus->pu8Tris |= psBus->u8SdaMask;
+    __delay_us(I2C_RECOVER_WAIT);
+    // MSSPの再初期化
+    bMstStartFlg[psBus->u8BusNo - 1] = false;
+    *psBus->pu8Con2 &= ~SSP_CON2_BUSY;
+    *psBus->pu8SspIF &= ~psBus->u8SspMask;
+    *psBus->pu8BclIF &= ~psBus->u8BclMask;
+    *psBus->pu8Con1 = u8Con1;
+}
+
+/*******************************************************************************
+ *
+ * NAME: vSlaveWait
+ *
+ * DESCRIPTION:I2Cスレーブのウェイト処理
+ *
+ * PARAMETERS:  Name            RW  Usage
+ *  tsI2C_Bus*  psBus           R   バス記述子
  *
  * RETURNS:
  *
  * NOTES:
  * None.
  ******************************************************************************/
+static void vSlaveWait(const tsI2C_Bus *psBus) {
+    while((*psBus->pu8Stat & SSP_STAT_BF) || (*psBus->pu8Con1 & SSP_CON1_CKP));
+}
+
+/*******************************************************************************
+ *
+ * NAME: vMstBeginSSP2
+ *
+ * DESCRIPTION:非同期トランザクションの開始処理
+ *
+ * PARAMETERS:  Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * キュー先頭のトランザクションのスタートコンディションを送信する。
+ * 割り込み内からも呼び出される為、完了を待たずにレジスタの書き込みのみ行う。
+ * 直前の処理（同期処理のストップコンディション等）が実行中の場合は、その完了の
+ * SSP2IFでスタートコンディションを送信する。
+ ******************************************************************************/
 #ifdef SSP2STAT
-static void vMasterWaitSSP2() {
-    while ((SSP2STAT & 0x04) || (SSP2CON2 & 0x1F));
+static void vMstBeginSSP2() {
+    psMstQueueSSP2[u8MstQueueBeginSSP2]->u8Status = I2C_TRANS_RUNNING;
+    u8MstIdxSSP2 = 0;
+    SSP2IF = 0;
+    if ((SSP2STAT & SSP_STAT_R_W) != 0 || (SSP2CON2 & SSP_CON2_BUSY) != 0) {
+        // 直前の処理の完了待ち
+        eMstStepSSP2 = MST_STEP_WAIT;
+    } else {
+        // スタートコンディションの送信
+        eMstStepSSP2 = MST_STEP_START;
+        SSP2CON2bits.SEN = 1;
+    }
+    SSP2IE = 1;
 }
 #endif
 
 /*******************************************************************************
  *
- * NAME: vSlaveWaitSSP1
+ * NAME: vMstStopSSP2
  *
- * DESCRIPTION:I2C}X^[̃EFCg
+ * DESCRIPTION:非同期トランザクションのストップ処理
  *
  * PARAMETERS:  Name            RW  Usage
+ *       uint8  u8Status        R   処理結果
  *
  * RETURNS:
  *
  * NOTES:
  * None.
  ******************************************************************************/
-static void vSlaveWaitSSP1() {
-    while((SSP1STATbits.BF) || (SSP1CON1bits.CKP));
+#ifdef SSP2STAT
+static void vMstStopSSP2(uint8 u8Status) {
+    u8MstResultSSP2 = u8Status;
+    SSP2CON2bits.PEN = 1;
+    eMstStepSSP2 = MST_STEP_STOP;
 }
+#endif
 
 /*******************************************************************************
  *
- * NAME: vSlaveWaitSSP2
+ * NAME: vMstFinishSSP2
  *
- * DESCRIPTION:I2C}X^[̃EFCg
+ * DESCRIPTION:非同期トランザクションの完了処理
  *
  * PARAMETERS:  Name            RW  Usage
  *
  * RETURNS:
  *
  * NOTES:
- * None.
+ * 完了通知後、次のトランザクションが有れば開始する
  ******************************************************************************/
 #ifdef SSP2STAT
-static void vSlaveWaitSSP2() {
-    while((SSP2STATbits.BF) || (SSP2CON1bits.CKP));
+static void vMstFinishSSP2() {
+    // キューからの取り出し
+    tsI2C_MstTrans *psTrans = psMstQueueSSP2[u8MstQueueBeginSSP2];
+    u8MstQueueBeginSSP2 = (u8MstQueueBeginSSP2 + 1) % I2C_MST_QUEUE_SIZE;
+    u8MstQueueSizeSSP2--;
+    // 完了通知
+    psTrans->u8Status = u8MstResultSSP2;
+    if (psTrans->pvCallback != NULL) {
+        psTrans->pvCallback(psTrans);
+    }
+    // 次のトランザクションの開始判定
+    if (u8MstQueueSizeSSP2 > 0) {
+        vMstBeginSSP2();
+    } else {
+        eMstStepSSP2 = MST_STEP_IDLE;
+        SSP2IE = 0;
+    }
+}
+#endif
+
+/*******************************************************************************
+ *
+ * NAME: vMstDrainSSP2
+ *
+ * DESCRIPTION:非同期トランザクションの完了待ち
+ *
+ * PARAMETERS:  Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 割り込みによる処理が進まないままI2C_WAIT_TIME（us）を超過した場合は、
+ * 登録済みのトランザクションを中断する。
+ ******************************************************************************/
+#ifdef SSP2STAT
+static void vMstDrainSSP2() {
+    uint8 u8Progress = u8MstProgressSSP2;
+    uint16 u16Start = timer1_u16GetTick();
+    while (u8MstQueueSizeSSP2 > 0) {
+        if (u8Progress != u8MstProgressSSP2) {
+            // 処理が進んでいる
+            u8Progress = u8MstProgressSSP2;
+            u16Start = timer1_u16GetTick();
+        } else if ((uint16)(timer1_u16GetTick() - u16Start)
+                        >= TIMER1_TICKS_US(I2C_WAIT_TIME)) {
+            // タイムアウト（中断中に登録されたトランザクションは改めて待つ）
+            vMstAbortSSP2();
+            u16Start = timer1_u16GetTick();
+        }
+    }
+}
+#endif
+
+/*******************************************************************************
+ *
+ * NAME: vMstAbortSSP2
+ *
+ * DESCRIPTION:非同期トランザクションの中断処理
+ *
+ * PARAMETERS:  Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 登録済みの全てのトランザクションをバスエラーとして完了通知し、バスを復旧する。
+ * 主処理から呼び出し、バスの復旧は割り込みを禁止せずに行う。完了通知中に
+ * 登録されたトランザクションは復旧後に開始する。
+ ******************************************************************************/
+#ifdef SSP2STAT
+static void vMstAbortSSP2() {
+    // クリティカルセクション開始
+    criticalSec_vBegin();
+    SSP2IE = 0;
+    // 完了通知中の登録ではトランザクションを開始しない
+    eMstStepSSP2 = MST_STEP_WAIT;
+    uint8 u8Cnt = u8MstQueueSizeSSP2;
+    for (; u8Cnt > 0; u8Cnt--) {
+        tsI2C_MstTrans *psTrans = psMstQueueSSP2[u8MstQueueBeginSSP2];
+        u8MstQueueBeginSSP2 = (u8MstQueueBeginSSP2 + 1) % I2C_MST_QUEUE_SIZE;
+        u8MstQueueSizeSSP2--;
+        psTrans->u8Status = I2C_TRANS_BUS_ERROR;
+        if (psTrans->pvCallback != NULL) {
+            psTrans->pvCallback(psTrans);
+        }
+    }
+    // クリティカルセクション終了
+    criticalSec_vEnd();
+    // バスの復旧
+    vRecover(I2C_BUS_SSP2);
+    // 完了通知中に登録されたトランザクションの開始
+    criticalSec_vBegin();
+    if (u8MstQueueSizeSSP2 > 0) {
+        vMstBeginSSP2();
+    } else {
+        eMstStepSSP2 = MST_STEP_IDLE;
+    }
+    criticalSec_vEnd();
 }
 #endif
 
 /*******************************************************************************
  *
- * NAME: vDmyCallback
+ * NAME: bDmyCallback
  *
- * DESCRIPTION:R[obN֐̃_~[
+ * DESCRIPTION:コールバック関数のダミー
  *
  * PARAMETERS:  Name            RW  Usage
- *       uint8  u8BusNo         R   SPPԍ
- *       uint8  u8EvtType       R   Cxg^Cv
+ *       uint8  u8BusNo         R   SPP番号
+ *       uint8  u8EvtType       R   イベントタイプ
  *
  * RETURNS:
+ *    bool true:SCLラインを開放する
  *
  * NOTES:
  * None.
  ******************************************************************************/
-static void vDmyCallback(uint8 u8BusNo, uint8 u8EvtType) {
-    return;
+static bool bDmyCallback(uint8 u8BusNo, uint8 u8EvtType) {
+    return true;
 }
 
 /******************************************************************************/
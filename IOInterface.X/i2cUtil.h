@@ -32,55 +32,163 @@ extern "C" {
 /******************************************************************************/
 /***       Macro Definitions                                                ***/
 /******************************************************************************/
-#define I2C_MASTER_1 8                  // Mf[^obt@̃TCY
-#define SND_DATA_LEN 8                  // Mf[^obt@̃TCY
-#define RCV_DATA_LEN 8                  // Mf[^obt@̃TCY
+#define I2C_MASTER_1 8                  // 送信データバッファのサイズ
+#define SND_DATA_LEN 8                  // 送信データバッファのサイズ
+#define RCV_DATA_LEN 8                  // 受信データバッファのサイズ
+
+// 非同期トランザクションキューのサイズ（LCDはデバイス毎に１件のみ登録する）
+#ifndef I2C_MST_QUEUE_SIZE
+#define I2C_MST_QUEUE_SIZE      (2)
+#endif
+
+// マスターのウェイト処理の最大待ち時間（us単位、超過時はタイムアウトとしてバスを復旧する）
+// Timer1（TIMER1_TICKS_US）で計測する為、16MHzでは131msまで指定できる
+#ifndef I2C_WAIT_TIME
+#define I2C_WAIT_TIME           (2000)
+#endif
+
+// I2Cの通信速度（bps）
+#define I2C_BAUD_STD            (100000UL)      // 標準モード
+#define I2C_BAUD_HIGH           (400000UL)      // 高速モード
+#define I2C_BAUD_FAST_PLUS      (1000000UL)     // Fast-mode Plus
+
+// マスターのクロック分割値（SSPxADD）を_XTAL_FREQと通信速度（bps）から算出
+// 通信速度が指定値を超えない様に切り上げ、SSPxADDの有効範囲（3-255）外の
+// 組み合わせはコンパイルエラー（配列サイズが負）とする
+#define I2C_CLK_DIV(bps)        ((uint8)(I2C_CLK_DIV_VAL(bps) \
+    + 0 * sizeof(char[(I2C_CLK_DIV_VAL(bps) >= 3 && I2C_CLK_DIV_VAL(bps) <= 255) ? 1 : -1])))
+#define I2C_CLK_DIV_VAL(bps)    \
+    (((unsigned long)(_XTAL_FREQ) + 4 * (bps) - 1) / (4 * (bps)) - 1)
+
+// I2Cバス記述子
+#define I2C_BUS_SSP1            (&I2C_sBusSSP1)
+#ifdef SSP2STAT
+#define I2C_BUS_SSP2            (&I2C_sBusSSP2)
+#endif
+
+// SSP1/SSP2固有の関数名（バス記述子を指定した共通関数の呼び出しに展開する）
+#define I2C_vInitMasterSSP1(eMode, u8ClkDiv) \
+    I2C_vInitMaster(I2C_BUS_SSP1, eMode, u8ClkDiv)
+#define I2C_vInitSlaveSSP1(u8Address, eMode, pbCallback) \
+    I2C_vInitSlave(I2C_BUS_SSP1, u8Address, eMode, pbCallback)
+#define I2C_vSlaveReleaseSSP1()     I2C_vSlaveRelease(I2C_BUS_SSP1)
+#define I2C_u8MstStartSSP1(u8Address, bReadFlg) \
+    I2C_u8MstStart(I2C_BUS_SSP1, u8Address, bReadFlg)
+#define I2C_vMstStopSSP1()          I2C_vMstStop(I2C_BUS_SSP1)
+#define I2C_u8MstTxSSP1(u8Data)     I2C_u8MstTx(I2C_BUS_SSP1, u8Data)
+#define I2C_u8MstRxSSP1(bNackFlg)   I2C_u8MstRx(I2C_BUS_SSP1, bNackFlg)
+#ifdef SSP2STAT
+#define I2C_vInitMasterSSP2(eMode, u8ClkDiv) \
+    I2C_vInitMaster(I2C_BUS_SSP2, eMode, u8ClkDiv)
+#define I2C_vInitSlaveSSP2(u8Address, eMode, pbCallback) \
+    I2C_vInitSlave(I2C_BUS_SSP2, u8Address, eMode, pbCallback)
+#define I2C_vSlaveReleaseSSP2()     I2C_vSlaveRelease(I2C_BUS_SSP2)
+#define I2C_u8MstStartSSP2(u8Address, bReadFlg) \
+    I2C_u8MstStart(I2C_BUS_SSP2, u8Address, bReadFlg)
+#define I2C_vMstStopSSP2()          I2C_vMstStop(I2C_BUS_SSP2)
+#define I2C_u8MstTxSSP2(u8Data)     I2C_u8MstTx(I2C_BUS_SSP2, u8Data)
+#define I2C_u8MstRxSSP2(bNackFlg)   I2C_u8MstRx(I2C_BUS_SSP2, bNackFlg)
+#endif
 
 /******************************************************************************/
 /***        Type Definitions                                                ***/
 /******************************************************************************/    
 //====================================================================
-// I2C}X^[[h
+// I2Cマスターモード
 //====================================================================
 enum I2C_MasterMode {
-    I2C_MASTER_STD          // I2CX[uW[hi100KHzj
-   ,I2C_MASTER_HIGH         // I2CX[u[hi400KHzj
+    I2C_MASTER_STD          // I2Cスレーブ標準モード（100KHz）
+   ,I2C_MASTER_HIGH         // I2Cスレーブ高速モード（400KHz）
+   ,I2C_MASTER_FAST_PLUS    // I2C Fast-mode Plus（1MHz）
 };
 
 //====================================================================
-// I2CX[u[h
+// I2Cスレーブモード
 //====================================================================
 enum I2C_SlaveMode {
-    I2C_SLAVE_STD           // SSP1 I2CX[uW[hi100KHzj
-   ,I2C_SLAVE_HIGH          // SSP1 I2CX[u[hi400KHzj
+    I2C_SLAVE_STD           // SSP1 I2Cスレーブ標準モード（100KHz）
+   ,I2C_SLAVE_HIGH          // SSP1 I2Cスレーブ高速モード（400KHz）
 };
 
 //====================================================================
-// I2C}X^[NbNl
+// I2Cマスターの処理結果
 //====================================================================
-enum I2C_ClockDiv {
-    I2C_CLK_DIV_STD_4MHZ   = 0x09,  // 100Kbps |  4MHz(_XTAL_FREQ= 4000000)
-    I2C_CLK_DIV_STD_8MHZ   = 0x13,  // 100Kbps |  8MHz(_XTAL_FREQ= 8000000)
-    I2C_CLK_DIV_STD_16MHZ  = 0x27,  // 100Kbps | 16MHz(_XTAL_FREQ=16000000)
-    I2C_CLK_DIV_STD_32MHZ  = 0x4F,  // 100Kbps | 32MHz(_XTAL_FREQ=32000000)
-    I2C_CLK_DIV_HIGH_8MHZ  = 0x04,  // 400Kbps |  8MHz(_XTAL_FREQ= 8000000)
-    I2C_CLK_DIV_HIGH_16MHZ = 0x09,  // 400Kbps | 16MHz(_XTAL_FREQ=16000000)
-    I2C_CLK_DIV_HIGH_32MHZ = 0x13,  // 400Kbps | 32MHz(_XTAL_FREQ=32000000)
+enum I2C_MstResult {
+    I2C_MST_ACK     = 0x00,     // ACK受信
+    I2C_MST_NACK    = 0x01,     // NACK受信
+    I2C_MST_TIMEOUT = 0x02      // タイムアウト又はバス衝突（次のスタートまで処理を中断）
 };
 
 //====================================================================
-// I2CX[uCxg
-// SSPxSTATR/WAD/AABFASSPxCON2WX^ACKSTAT琶
+// I2Cスレーブイベント種別
+// SSPxSTATのR/W、D/A、BF、SSPxCON2レジスタのACKSTATから生成
+// ストップコンディション検出時はSSPxSTATのPのみ
 //====================================================================
 enum I2C_SlaveEvent {
-    I2C_SLV_EVT_WRITE_ADDR = 0b00000001,    // ݗvAhXM
-    I2C_SLV_EVT_WRITE_DATA = 0b00100001,    // ݗvf[^M
-    I2C_SLV_EVT_READ_ADDR  = 0b00000101,    // ǂݏovAhXM
-    I2C_SLV_EVT_READ_ACK   = 0b00100100,    // ǂݏovACKM
-    I2C_SLV_EVT_READ_NACK  = 0b01100100,    // ǂݏovNACKM
-    I2C_SLV_EVT_BUS_ERROR  = 0b11111111     // oXG[ioXՓ˓j
+    I2C_SLV_EVT_WRITE_ADDR = 0b00000001,    // 書き込み要求アドレス受信
+    I2C_SLV_EVT_WRITE_DATA = 0b00100001,    // 書き込み要求データ受信
+    I2C_SLV_EVT_READ_ADDR  = 0b00000101,    // 読み出し要求アドレス受信
+    I2C_SLV_EVT_READ_ACK   = 0b00100100,    // 読み出し要求ACK応答受信
+    I2C_SLV_EVT_READ_NACK  = 0b01100100,    // 読み出し要求NACK応答受信
+    I2C_SLV_EVT_STOP       = 0b00010000,    // ストップコンディション検出
+    I2C_SLV_EVT_BUS_ERROR  = 0b11111111     // バスエラー（バス衝突等）
 };
 
+//====================================================================
+// I2Cマスタートランザクション状態
+//====================================================================
+enum I2C_TransStatus {
+    I2C_TRANS_IDLE          // 未登録
+   ,I2C_TRANS_QUEUED        // 実行待ち
+   ,I2C_TRANS_RUNNING       // 実行中
+   ,I2C_TRANS_COMPLETE      // 正常終了
+   ,I2C_TRANS_NACK          // NACK受信による中断
+   ,I2C_TRANS_BUS_ERROR     // バスエラー（バス衝突等）による中断
+};
+
+/**
+ * I2Cバス記述子
+ * MSSPモジュール毎のレジスタと割り込みフラグ、SCL/SDAピンの位置を保持する。
+ * 割り込みフラグと割り込み許可はPIRxとPIExの同じビット位置にある。
+ */
+typedef struct {
+    uint8 u8BusNo;                                  // バス番号（1:SSP1、2:SSP2）
+    volatile uint8 *pu8Buf;                         // SSPxBUF
+    volatile uint8 *pu8Stat;                        // SSPxSTAT
+    volatile uint8 *pu8Con1;                        // SSPxCON1
+    volatile uint8 *pu8Con2;                        // SSPxCON2
+    volatile uint8 *pu8Con3;                        // SSPxCON3
+    volatile uint8 *pu8Add;                         // SSPxADD
+    volatile uint8 *pu8Msk;                         // SSPxMSK
+    volatile uint8 *pu8SspIF;                       // SSPxIFを含むPIRx
+    volatile uint8 *pu8SspIE;                       // SSPxIEを含むPIEx
+    uint8 u8SspMask;                                // SSPxIF/SSPxIEのビットマスク
+    volatile uint8 *pu8BclIF;                       // BCLxIFを含むPIRx
+    volatile uint8 *pu8BclIE;                       // BCLxIEを含むPIEx
+    uint8 u8BclMask;                                // BCLxIF/BCLxIEのビットマスク
+    volatile uint8 *pu8Tris;                        // SCL/SDAピンのTRISx
+    volatile uint8 *pu8Lat;                         // SCL/SDAピンのLATx
+    uint8 u8SclMask;                                // SCLピンのビットマスク
+    uint8 u8SdaMask;                                // SDAピンのビットマスク
+} tsI2C_Bus;
+
+/**
+ * I2Cマスタートランザクション記述子
+ * 送信ヘッダ、送信データの順に書き込んだ後、受信データ長が1以上の場合には
+ * リスタートして受信データを読み込む。送受信バッファは完了通知まで保持する事。
+ */
+typedef struct tsI2C_MstTrans {
+    uint8 u8Address;                                // I2Cアドレス（7bit）
+    uint8 *pu8TxHead;                               // 送信ヘッダ（送信データの前に送信）
+    uint8 u8TxHeadLen;                              // 送信ヘッダ長
+    uint8 *pu8TxData;                               // 送信データ
+    uint8 u8TxLen;                                  // 送信データ長
+    uint8 *pu8RxData;                               // 受信データ
+    uint8 u8RxLen;                                  // 受信データ長
+    void (*pvCallback)(struct tsI2C_MstTrans *psTrans);  // 完了通知（割り込み内で実行）
+    volatile uint8 u8Status;                        // 状態（I2C_TransStatus）
+} tsI2C_MstTrans;
+
 /******************************************************************************/
 /***        Local Function Prototypes                                       ***/
 /******************************************************************************/
@@ -88,6 +196,12 @@ enum I2C_SlaveEvent {
 /******************************************************************************/
 /***        Exported Variables                                              ***/
 /******************************************************************************/
+/** SSP1のバス記述子 */
+extern const tsI2C_Bus I2C_sBusSSP1;
+#ifdef SSP2STAT
+/** SSP2のバス記述子 */
+extern const tsI2C_Bus I2C_sBusSSP2;
+#endif
 
 /******************************************************************************/
 /***        Local Variables                                                 ***/
@@ -97,56 +211,46 @@ enum I2C_SlaveEvent {
 /***        Exported Functions                                              ***/
 /******************************************************************************/
 
-/** I2C̃}X^[[hŏ */
-extern void I2C_vInitMasterSSP1(enum I2C_MasterMode eMode, uint8 u8ClkDiv);
-
-#ifdef SSP2STAT
-/** I2C̃}X^[[hŏ */
-extern void I2C_vInitMasterSSP2(enum I2C_MasterMode eMode, uint8 u8ClkDiv);
-#endif
+/** I2Cのマスターモードで初期化する */
+extern void I2C_vInitMaster(const tsI2C_Bus *psBus,
+                            enum I2C_MasterMode eMode, uint8 u8ClkDiv);
 
-/** I2C̃X[u[hŏ */
-extern void I2C_vInitSlaveSSP1(uint8 u8Address,
+/** I2Cのスレーブモードで初期化する */
+extern void I2C_vInitSlave(const tsI2C_Bus *psBus, uint8 u8Address,
                             enum I2C_SlaveMode eMode,
-                            void (*pvCallback)(uint8 u8BusNo, uint8 u8EvtType));
+                            bool (*pbCallback)(uint8 u8BusNo, uint8 u8EvtType));
 
-#ifdef SSP2STAT
-/** I2C̃X[u[hŏ */
-extern void I2C_vInitSlaveSSP2(uint8 u8Address,
-                            enum I2C_SlaveMode eMode,
-                            void (*pvCallback)(uint8 u8BusNo, uint8 u8EvtType));
-#endif
+/** I2Cスレーブの保持しているSCLラインを開放する */
+extern void I2C_vSlaveRelease(const tsI2C_Bus *psBus);
 
-/** I2C̃}X^[̃X^[g */
-extern uint8 I2C_u8MstStartSSP1(uint8 u8Address, bool bReadFlg);
+/** I2Cのマスターのスタート処理 */
+extern uint8 I2C_u8MstStart(const tsI2C_Bus *psBus, uint8 u8Address, bool bReadFlg);
 
-#ifdef SSP2STAT
-/** I2C̃}X^[̃X^[g */
-extern uint8 I2C_u8MstStartSSP2(uint8 u8Address, bool bReadFlg);
-#endif
+/** I2Cのマスターのストップ処理 */
+extern void I2C_vMstStop(const tsI2C_Bus *psBus);
 
-/** I2C̃}X^[̃Xgbv */
-extern void I2C_vMstStopSSP1();
+/** I2Cのマスターの送信処理 */
+extern uint8 I2C_u8MstTx(const tsI2C_Bus *psBus, uint8 u8Data);
 
-#ifdef SSP2STAT
-/** I2C̃}X^[̃Xgbv */
-extern void I2C_vMstStopSSP2();
-#endif
+/** I2Cのマスターの受信処理 */
+extern uint8 I2C_u8MstRx(const tsI2C_Bus *psBus, bool bNackFlg);
 
-/** I2C̃}X^[̑M */
-extern uint8 I2C_u8MstTxSSP1(uint8 u8Data);
+/** I2Cのマスターのエラー判定 */
+extern bool I2C_bMstError(const tsI2C_Bus *psBus);
 
 #ifdef SSP2STAT
-/** I2C̃}X^[̑M */
-extern uint8 I2C_u8MstTxSSP2(uint8 u8Data);
+/** I2Cマスターの非同期トランザクション登録 */
+extern bool I2C_bMstSubmitSSP2(tsI2C_MstTrans *psTrans);
 #endif
 
-/** I2C̃}X^[̎M */
-extern uint8 I2C_u8MstRxSSP1(bool bAckFlg);
+#ifdef SSP2STAT
+/** I2Cマスターの非同期トランザクション実行中判定 */
+extern bool I2C_bMstBusySSP2();
+#endif
 
 #ifdef SSP2STAT
-/** I2C̃}X^[̎M */
-extern uint8 I2C_u8MstRxSSP2(bool bAckFlg);
+/** I2Cマスターの非同期トランザクション完了待ち */
+extern void I2C_vMstDrainSSP2();
 #endif
 
 /** SSP1 interrupt processing */
@@ -157,6 +261,11 @@ extern void I2C_vSlaveIsrSSP1();
 extern void I2C_vSlaveIsrSSP2();
 #endif
 
+#ifdef SSP2STAT
+/** SSP2 master interrupt processing */
+extern void I2C_vMasterIsrSSP2();
+#endif
+
 /******************************************************************************/
 /***        Local Functions                                                 ***/
 /******************************************************************************/
@@ -28,7 +28,7 @@
 /***        Macro Definitions                                               ***/
 /******************************************************************************/
 // KeyPad Check Cycle
-// b128̃`FbNz
+// 秒間128回のチェックを想定
 #ifndef KEYPAD_CHK_CNT_0
 #define KEYPAD_CHK_CNT_0 (6)
 #endif
@@ -41,6 +41,11 @@
 #ifndef KEYPAD_CHK_CNT_3
 #define KEYPAD_CHK_CNT_3 (268)
 #endif
+// 実行時設定の初期値（チェック回数から算出）
+#define KEYPAD_DEBOUNCE_DEF     (KEYPAD_CHK_CNT_0)
+#define KEYPAD_REPEAT_DELAY_DEF (KEYPAD_CHK_CNT_1)
+#define KEYPAD_REPEAT_RATE_DEF  (KEYPAD_CHK_CNT_3 - KEYPAD_CHK_CNT_2)
+#define KEYPAD_REPEAT_ACCEL_DEF (KEYPAD_CHK_CNT_2 - KEYPAD_CHK_CNT_1 - KEYPAD_REPEAT_RATE_DEF)
 
 /******************************************************************************/
 /***        Type Definitions                                                ***/
@@ -49,8 +54,24 @@
 /******************************************************************************/
 /***        Local Function Prototypes                                       ***/
 /******************************************************************************/
-// {^Ă̓ǂݍ
-static uint8 readColumn();
+// ボタンが押下されている列の読み込み
+static uint8 readColumns();
+// ピンマップのポート番号取得
+static uint8 portIndex(uint16 u16PinMap);
+// ポートの読み込み
+static uint8 readPort(uint8 u8Port);
+// ポートへの書き込み
+static void writePort(uint8 u8Port, uint8 u8Value);
+// ゴーストの判定
+static bool keyGhost(uint16 u16Map);
+// キー毎の状態遷移
+static uint8 keyUpdate(uint16 u16Raw);
+// キー毎の判定回数の取得
+static uint8 keyCount(uint8 u8Idx);
+// キー毎の判定回数の設定
+static void keySetCount(uint8 u8Idx, uint8 u8Cnt);
+// キーイベントの通知
+static void keyEvent(uint8 u8KeyNo, uint8 u8Type);
 
 /******************************************************************************/
 /***        Exported Variables                                              ***/
@@ -59,7 +80,7 @@ static uint8 readColumn();
 /******************************************************************************/
 /***        Local Variables                                                 ***/
 /******************************************************************************/
-// foCX
+// デバイス情報
 static tsKEYPAD_status *spKEYPAD_status;
 
 /******************************************************************************/
@@ -70,30 +91,60 @@ static tsKEYPAD_status *spKEYPAD_status;
  *
  * NAME: KEYPAD_vInit
  *
- * DESCRIPTION:L[pbh̏
+ * DESCRIPTION:キーパッドの初期化処理
  *
  * PARAMETERS:      Name            RW  Usage
- * tsKEYPAD_status  *spStatus       R   foCXXe[^X
+ * tsKEYPAD_status  *spStatus       R   デバイスステータス情報
  *
  * RETURNS:
  *
  * NOTES:
- * None.
+ * 走査時に列ピン毎にポートを読み込まないように、ポート毎の列ピンのマスクを
+ * ここで生成する。
  ******************************************************************************/
 extern void KEYPAD_vInit(tsKEYPAD_status *spStatus) {
     if (spStatus == NULL) {
         return;
     }
-    // L[̓Xe[^X
-    spStatus->u8BeforeKeyNo  = 0;
-    spStatus->u16KeyChkCnt    = 0;
-     // obt@Xe[^X
+    // 列ピンのピンマップからポート毎のマスクを生成
+    uint8 u8Idx;
+    uint8 u8Port;
+    memset(spStatus->u8SenseMask, 0x00, KEYPAD_PORT_CNT);
+    for (u8Idx = 0; u8Idx < KEYPAD_COL_SIZE; u8Idx++) {
+        u8Port = portIndex(spStatus->u16PinCols[u8Idx]);
+        if (u8Port != KEYPAD_PORT_NONE) {
+            spStatus->u8SenseMask[u8Port] |= (uint8)spStatus->u16PinCols[u8Idx];
+        }
+    }
+    // 実行時設定の初期化
+    spStatus->u8Debounce     = KEYPAD_DEBOUNCE_DEF;
+    spStatus->u8RepeatDelay  = KEYPAD_REPEAT_DELAY_DEF;
+    spStatus->u8RepeatRate   = KEYPAD_REPEAT_RATE_DEF;
+    spStatus->u8RepeatAccel  = KEYPAD_REPEAT_ACCEL_DEF;
+    // キー毎の状態初期化
+    memset(spStatus->u8KeyCnt, 0x00, sizeof(spStatus->u8KeyCnt));
+    spStatus->u16Pressed     = 0x0000;
+    spStatus->u16Pending     = 0x0000;
+    spStatus->u8RepeatIdx    = 0xFF;
+    spStatus->u8RepeatCnt    = 0;
+    spStatus->u8RepeatIntvl  = 0;
+    spStatus->bRepeating     = false;
+    // 走査状態初期化（最終行の走査完了として扱い、先頭行の駆動から開始）
+    spStatus->u8ScanRow      = KEYPAD_ROW_SIZE - 1;
+    spStatus->u16ScanMap     = 0x0000;
+    spStatus->u16KeyState    = 0x0000;
+    spStatus->bGhost         = false;
+    // キーイベント初期化
+    spStatus->u8EventKeyNo   = 0xFF;
+    spStatus->u8EventType    = KEYPAD_EVT_NONE;
+    spStatus->pvCallback     = NULL;
+     // バッファステータス初期化
     spStatus->u8BuffSize     = 0;
     spStatus->u8BuffBeginIdx = 0;
     spStatus->u8BuffEndIdx   = KEYPAD_BUFF_SIZE - 1;
-    // L[obt@̏
+    // キーバッファの初期化
     memset(spStatus->u8KeyBuffer, 0x00, KEYPAD_BUFF_SIZE);
-    // foCXXe[^X
+    // デバイスステータス情報
     spKEYPAD_status = spStatus;
 }
 
@@ -101,35 +152,55 @@ extern void KEYPAD_vInit(tsKEYPAD_status *spStatus) {
  *
  * NAME: KEYPAD_bUpdateBuffer
  *
- * DESCRIPTION:obt@XV
+ * DESCRIPTION:バッファ更新
  *
  * PARAMETERS:      Name            RW  Usage
  *
  * RETURNS:
- *    bool_t        TRUE:XV
+ *    bool_t        TRUE:更新成功
  *
  * NOTES:
  * None.
  ******************************************************************************/
 extern bool KEYPAD_bUpdateBuffer() {
-    // obt@O
+    // バッファリング判定
     if (spKEYPAD_status->u8BuffSize >= KEYPAD_BUFF_SIZE) {
-        // obt@t̏ꍇ
+        // バッファが一杯の場合
         return false;
     }
-    // L[ԍǂݍ
-    uint8 u8KeyNo = KEYPAD_u8Read();
-    if (u8KeyNo == 0xFF) {
+    // キー番号読み込み
+    return KEYPAD_bWriteBuffer(KEYPAD_u8Read());
+}
+
+/*******************************************************************************
+ *
+ * NAME: KEYPAD_bWriteBuffer
+ *
+ * DESCRIPTION:キー番号のバッファリング
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *      uint8       u8KeyNo         R   走査済みのキー番号
+ *
+ * RETURNS:
+ *    bool_t        TRUE:更新成功
+ *
+ * NOTES:
+ * KEYPAD_u8ScanStep等で走査済みのキー番号をバッファに追加する。
+ * 同じ割り込みで走査を重ねずにバッファを更新する場合に使用する。
+ ******************************************************************************/
+extern bool KEYPAD_bWriteBuffer(uint8 u8KeyNo) {
+    // バッファリング判定
+    if (spKEYPAD_status->u8BuffSize >= KEYPAD_BUFF_SIZE || u8KeyNo == 0xFF) {
         return false;
     }
-    // NeBJZNVJn
+    // クリティカルセクション開始
     criticalSec_vBegin();
-    // obt@O
+    // バッファリング
     uint8 u8Idx = (spKEYPAD_status->u8BuffEndIdx + 1) % KEYPAD_BUFF_SIZE;
     spKEYPAD_status->u8KeyBuffer[u8Idx] = u8KeyNo;
     spKEYPAD_status->u8BuffEndIdx = u8Idx;
     spKEYPAD_status->u8BuffSize++;
-    // NeBJZNVI
+    // クリティカルセクション終了
     criticalSec_vEnd();
     return true;
 }
@@ -138,12 +209,12 @@ extern bool KEYPAD_bUpdateBuffer() {
  *
  * NAME: KEYPAD_u8BufferSize
  *
- * DESCRIPTION:obt@TCY擾
+ * DESCRIPTION:バッファサイズ取得
  *
  * PARAMETERS:      Name            RW  Usage
  *
  * RETURNS:
- *    uint8         obt@TCY
+ *    uint8         バッファサイズ
  *
  * NOTES:
  * None.
@@ -156,24 +227,24 @@ extern uint8 KEYPAD_u8BufferSize() {
  *
  * NAME: KEYPAD_vClearBuffer
  *
- * DESCRIPTION:obt@NA
+ * DESCRIPTION:バッファクリア
  *
  * PARAMETERS:      Name            RW  Usage
  *
  * RETURNS:
- *   bool_t true:obt@NA
+ *   bool_t true:バッファクリア成功
  *
  * NOTES:
  * None.
  ******************************************************************************/
 extern void KEYPAD_vClearBuffer() {
-    // NeBJZNVJn
+    // クリティカルセクション開始
     criticalSec_vBegin();
-    // obt@NA
+    // バッファクリア
     spKEYPAD_status->u8BuffSize     = 0;
     spKEYPAD_status->u8BuffBeginIdx = 0;
     spKEYPAD_status->u8BuffEndIdx   = KEYPAD_BUFF_SIZE - 1;
-    // NeBJZNVI
+    // クリティカルセクション終了
     criticalSec_vEnd();
 }
 
@@ -181,118 +252,197 @@ extern void KEYPAD_vClearBuffer() {
  *
  * NAME:  KEYPAD_u8Read
  *
- * DESCRIPTION:݃L[l̓ǂݍ
+ * DESCRIPTION:現在キー値の読み込み
  *
  * PARAMETERS:      Name            RW  Usage
- *      uint8*      pu8Key          W   ǂݍ݃L[
+ *      uint8*      pu8Key          W   読み込みキー
  *
  * RETURNS:
- *   uint8 ݂̃L[ԍA͎ɂ0xFFԋp
+ *   uint8 押下、長押し、リピートを検出したキー番号、検出無しの場合は0xFF
  *
  * NOTES:
- * None.
+ * 全ての行と列を走査して同時押しを含むキー状態を判定する。
  ******************************************************************************/
 extern uint8 KEYPAD_u8Read() {
-    // |[g`FbN
-    uint8 u8PortA = PORTA;
+    // 行ピン駆動前のポート値
+    uint8 u8Base[KEYPAD_PORT_CNT];
+    u8Base[KEYPAD_PORT_A] = PORTA;
 #ifdef PORTB
-    uint8 u8PortB = PORTB;
+    u8Base[KEYPAD_PORT_B] = PORTB;
 #endif
 #ifdef PORTC
-    uint8 u8PortC = PORTC;
+    u8Base[KEYPAD_PORT_C] = PORTC;
 #endif
-    // L[̓`FbN
-    uint16 u16PinMap;
-    uint8 u8Col;
+    // キー入力チェック（全ての行を走査してキー状態ビットマップを作成）
+    uint8 u8Port;
+    uint8 u8DrivePort = KEYPAD_PORT_NONE;
+    uint16 u16Raw = 0x0000;
     uint8 u8Row;
     for (u8Row = 0; u8Row < KEYPAD_ROW_SIZE; u8Row++) {
-        // PsƂɃ{^𑖍
-        u16PinMap = spKEYPAD_status->u16PinRows[u8Row];
-        switch (u16PinMap & 0xFF00) {
-            case ID_PORTA:
-                PORTA = u8PortA | (uint8)u16PinMap;
-                u8Col = readColumn();
-                PORTA = u8PortA;
-                break;
-#ifdef PORTB
-            case ID_PORTB:
-                PORTB = u8PortB | (uint8)u16PinMap;
-                u8Col = readColumn();
-                PORTB = u8PortB;
-                break;
-#endif
-#ifdef PORTC
-            case ID_PORTC:
-                PORTC = u8PortC | (uint8)u16PinMap;
-                u8Col = readColumn();
-                PORTC = u8PortC;
-                break;
-#endif
+        u8Port = portIndex(spKEYPAD_status->u16PinRows[u8Row]);
+        if (u8Port == KEYPAD_PORT_NONE) {
+            continue;
         }
-        // L[͔
-        if (u8Col != 0xFF) {
-            break;
+        // 前の行と異なるポートの場合は前の行の駆動を解除
+        if (u8DrivePort != u8Port && u8DrivePort != KEYPAD_PORT_NONE) {
+            writePort(u8DrivePort, u8Base[u8DrivePort]);
         }
+        // １行ごとにボタンを走査
+        writePort(u8Port, u8Base[u8Port] | (uint8)spKEYPAD_status->u16PinRows[u8Row]);
+        u8DrivePort = u8Port;
+        u16Raw |= (uint16)readColumns() << (u8Row * KEYPAD_COL_SIZE);
     }
-    // L[͔
-    if (u8Col == 0xFF) {
-        spKEYPAD_status->u8BeforeKeyNo = 0xFF;
-        spKEYPAD_status->u16KeyChkCnt   = 0;
-        return 0xFF;
+    // 行ピンの駆動を解除
+    if (u8DrivePort != KEYPAD_PORT_NONE) {
+        writePort(u8DrivePort, u8Base[u8DrivePort]);
     }
-    // L[ԍ擾
-    uint8 u8KeyNo = u8Row * KEYPAD_ROW_SIZE + u8Col;
-    // L[͔
-    if (u8KeyNo != spKEYPAD_status->u8BeforeKeyNo) {
-        spKEYPAD_status->u8BeforeKeyNo = u8KeyNo;
-        spKEYPAD_status->u16KeyChkCnt   = 1;
-        return 0xFF;
+    // ゴースト発生中は前回のキー状態を維持
+    spKEYPAD_status->bGhost = keyGhost(u16Raw);
+    if (spKEYPAD_status->bGhost) {
+        u16Raw = spKEYPAD_status->u16KeyState;
+    }
+    spKEYPAD_status->u16KeyState = u16Raw;
+    // キー毎の状態遷移
+    return keyUpdate(u16Raw);
+}
+
+/*******************************************************************************
+ *
+ * NAME:  KEYPAD_u8ScanStep
+ *
+ * DESCRIPTION:１行分の走査と現在キー値の読み込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   uint8 押下、長押し、リピートを検出したキー番号、検出無しの場合は0xFF
+ *
+ * NOTES:
+ * 前回の呼び出しで駆動した行の列を読み込んでキー状態ビットマップに蓄積し、
+ * 次の行を駆動して戻る。行の駆動から読み込みまでの間隔でポートを安定させる為、
+ * 待ち時間無しで一定時間の処理となる。キー値は全行の走査が完了した時点で
+ * 最新のキー状態から判定し、それ以外の呼び出しでは判定しない。その為、
+ * チャタリング判定回数とリピートの回数（u8Debounce等）はKEYPAD_ROW_SIZE回の
+ * 呼び出し毎に１回数える。KEYPAD_u8Readと混在させない事。
+ ******************************************************************************/
+extern uint8 KEYPAD_u8ScanStep() {
+    // 駆動中の行の列を読み込んで駆動を解除
+    uint8 u8Row  = spKEYPAD_status->u8ScanRow;
+    uint8 u8Port = portIndex(spKEYPAD_status->u16PinRows[u8Row]);
+    uint8 u8Pin  = (uint8)spKEYPAD_status->u16PinRows[u8Row];
+    if (u8Port != KEYPAD_PORT_NONE) {
+        spKEYPAD_status->u16ScanMap |= (uint16)readColumns() << (u8Row * KEYPAD_COL_SIZE);
+        writePort(u8Port, readPort(u8Port) & ~u8Pin);
+    }
+    // 次の行へ移動
+    u8Row++;
+    bool bComplete = (u8Row >= KEYPAD_ROW_SIZE);
+    if (bComplete) {
+        // 全行の走査完了（ゴースト発生中は前回のキー状態を維持）
+        spKEYPAD_status->bGhost = keyGhost(spKEYPAD_status->u16ScanMap);
+        if (!spKEYPAD_status->bGhost) {
+            spKEYPAD_status->u16KeyState = spKEYPAD_status->u16ScanMap;
+        }
+        spKEYPAD_status->u16ScanMap  = 0x0000;
+        u8Row = 0;
     }
-    // L[`FbN񐔃JEgAbv
-    spKEYPAD_status->u16KeyChkCnt++;
-    // `^OƉςȂ̔i̓^C~Oj
-    if (spKEYPAD_status->u16KeyChkCnt == KEYPAD_CHK_CNT_0 ||
-        spKEYPAD_status->u16KeyChkCnt == KEYPAD_CHK_CNT_1 ||
-        spKEYPAD_status->u16KeyChkCnt == KEYPAD_CHK_CNT_2) {
-        // {^ԍԋp
-        return u8KeyNo;
-    } else if (spKEYPAD_status->u16KeyChkCnt == KEYPAD_CHK_CNT_3) {
-        spKEYPAD_status->u16KeyChkCnt = KEYPAD_CHK_CNT_2;
-        // {^ԍԋp
-        return u8KeyNo;
+    spKEYPAD_status->u8ScanRow = u8Row;
+    // 次の行を駆動（読み込みは次回の呼び出し）
+    u8Port = portIndex(spKEYPAD_status->u16PinRows[u8Row]);
+    if (u8Port != KEYPAD_PORT_NONE) {
+        writePort(u8Port, readPort(u8Port) | (uint8)spKEYPAD_status->u16PinRows[u8Row]);
     }
-    // 
-    return 0xFF;
+    // 走査の途中ではキー状態が更新されない為、判定しない
+    if (!bComplete) {
+        return 0xFF;
+    }
+    // 最新のキー状態でキー毎の状態遷移
+    return keyUpdate(spKEYPAD_status->u16KeyState);
+}
+
+/*******************************************************************************
+ *
+ * NAME:  KEYPAD_u16ReadState
+ *
+ * DESCRIPTION:キー状態ビットマップの読み込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   uint16 押下されているキーのビットマップ（ビット番号は行 * 列サイズ + 列）
+ *
+ * NOTES:
+ * 最後に全行の走査が完了した時点の状態を返す（チャタリング判定前）。
+ ******************************************************************************/
+extern uint16 KEYPAD_u16ReadState() {
+    return spKEYPAD_status->u16KeyState;
+}
+
+/*******************************************************************************
+ *
+ * NAME:  KEYPAD_u16ReadPressed
+ *
+ * DESCRIPTION:確定済みのキー状態ビットマップの読み込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   uint16 押下を確定したキーのビットマップ（ビット番号は行 * 列サイズ + 列）
+ *
+ * NOTES:
+ * チャタリング判定後の状態で、押下と解放のイベントと同時に更新される。
+ ******************************************************************************/
+extern uint16 KEYPAD_u16ReadPressed() {
+    return spKEYPAD_status->u16Pressed;
+}
+
+/*******************************************************************************
+ *
+ * NAME:  KEYPAD_bGhost
+ *
+ * DESCRIPTION:ゴーストの検出状態
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *   bool_t         TRUE:最後の走査でゴーストを検出
+ *
+ * NOTES:
+ * 矩形の３隅のキーを押下すると残りの１隅も押下されたように見える為、
+ * 検出中はキー状態を更新しない。
+ ******************************************************************************/
+extern bool KEYPAD_bGhost() {
+    return spKEYPAD_status->bGhost;
 }
 
 /*******************************************************************************
  *
  * NAME: KEYPAD_u8ReadBuffer
  *
- * DESCRIPTION:obt@擪̓ǂݍ
+ * DESCRIPTION:バッファ先頭文字の読み込み
  *
  * PARAMETERS:      Name            RW  Usage
- *      uint8*      pu8Key          W   ǂݍ݃L[
+ *      uint8*      pu8Key          W   読み込みキー
  *
  * RETURNS:
- *   uint8 obt@̐擪L[ԍAobt@ĂȂꍇɂ0xFFԋp
+ *   uint8 バッファの先頭キー番号、バッファされていない場合には0xFFを返却
  *
  * NOTES:
  * None.
  ******************************************************************************/
 extern uint8 KEYPAD_u8ReadBuffer() {
-    // obt@̗L
+    // バッファ文字の有無判定
     if (spKEYPAD_status->u8BuffSize == 0) {
         return 0xFF;
     }
-    // NeBJZNVJn
+    // クリティカルセクション開始
     criticalSec_vBegin();
-    // obt@ǂݍ
+    // バッファ読み込み
     uint8 u8Idx = spKEYPAD_status->u8BuffBeginIdx;
     uint8 u8KeyNo = spKEYPAD_status->u8KeyBuffer[u8Idx];
     spKEYPAD_status->u8BuffBeginIdx = (u8Idx + 1) % KEYPAD_BUFF_SIZE;
     spKEYPAD_status->u8BuffSize--;
-    // NeBJZNVI
+    // クリティカルセクション終了
     criticalSec_vEnd();
     return u8KeyNo;
 }
@@ -301,92 +451,430 @@ extern uint8 KEYPAD_u8ReadBuffer() {
  *
  * NAME: KEYPAD_u8ReadFinal
  *
- * DESCRIPTION:obt@I[̓ǂݍ
+ * DESCRIPTION:バッファ終端文字の読み込み
  *
  * PARAMETERS:      Name            RW  Usage
  *
  * RETURNS:
- *   bool_t         TRUE:ǂݍݐ
+ *   bool_t         TRUE:読み込み成功
  *
  * NOTES:
  * None.
  ******************************************************************************/
 extern uint8 KEYPAD_u8ReadFinal() {
-    // obt@̗L
+    // バッファ文字の有無判定
     if (spKEYPAD_status->u8BuffSize == 0) {
         return 0xFF;
     }
-    // NeBJZNVJn
+    // クリティカルセクション開始
     criticalSec_vBegin();
-    // obt@ǂݍ
+    // バッファ読み込み
     uint8 u8KeyNo = spKEYPAD_status->u8KeyBuffer[spKEYPAD_status->u8BuffEndIdx];
-    // obt@NA
+    // バッファクリア
     spKEYPAD_status->u8BuffBeginIdx = 0;
     spKEYPAD_status->u8BuffEndIdx   = KEYPAD_BUFF_SIZE - 1;
     spKEYPAD_status->u8BuffSize     = 0;
-    // NeBJZNVI
+    // クリティカルセクション終了
     criticalSec_vEnd();
     return u8KeyNo;
 }
 
+/*******************************************************************************
+ *
+ * NAME: KEYPAD_u8ReadEvent
+ *
+ * DESCRIPTION:キーイベントの読み込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *      uint8*      pu8KeyNo        W   イベントのキー番号
+ *
+ * RETURNS:
+ *   uint8 イベント種別（KEYPAD_EVT_*）、未読イベントが無い場合はKEYPAD_EVT_NONE
+ *
+ * NOTES:
+ * KEYPAD_u8Readで検出した押下、解放、長押し、リピートのイベントを返却して
+ * クリアする。未読イベントは１件のみ保持し、読み込む前に次のイベントが
+ * 発生した場合は上書きされる。複数キーのイベントを全て受け取る場合は
+ * KEYPAD_vSetCallbackで通知先を登録する。KEYPAD_u8Readと同じ処理（タイマー割り込み等）から呼び出す事。
+ ******************************************************************************/
+extern uint8 KEYPAD_u8ReadEvent(uint8 *pu8KeyNo) {
+    // イベント読み込み
+    uint8 u8Type = spKEYPAD_status->u8EventType;
+    *pu8KeyNo = spKEYPAD_status->u8EventKeyNo;
+    spKEYPAD_status->u8EventType = KEYPAD_EVT_NONE;
+    return u8Type;
+}
+
+/*******************************************************************************
+ *
+ * NAME: KEYPAD_vSetCallback
+ *
+ * DESCRIPTION:キーイベント通知先の登録
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *      void*       pvCallback      R   通知先の関数（NULL:未読イベントとして保持）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 通知先はキーの走査処理（タイマー割り込み等）の中で呼び出される。
+ ******************************************************************************/
+extern void KEYPAD_vSetCallback(void (*pvCallback)(uint8 u8KeyNo, uint8 u8Type)) {
+    spKEYPAD_status->pvCallback = pvCallback;
+}
+
 /******************************************************************************/
 /***        Local Functions                                                 ***/
 /******************************************************************************/
 
 /*******************************************************************************
  *
- * NAME: readColumn
+ * NAME: readColumns
  *
- * DESCRIPTION:{^Ă̓ǂݍ
+ * DESCRIPTION:ボタン押下されている列の読み込み
  *
  * PARAMETERS:      Name            RW  Usage
  *
  * RETURNS:
- *   uint8 ͂ꂽԍA͎ɂ0xFFԋp
+ *   uint8 押下されている列のビットマップ（ビット番号が列番号）
  *
  * NOTES:
- * None.
+ * 各ポートを１回ずつ読み込み、列ピンのマスクで押下の有無を判定する。
+ * ビットマップの為、列サイズは8までとする。
  ******************************************************************************/
-static uint8 readColumn() {
-    // |[g`FbN
-    uint8 portA = PORTA;
+static uint8 readColumns() {
+    // ポート毎の入力（対象外のピンは常に未入力）
+    uint8 u8Sense[KEYPAD_PORT_CNT + 1];
+    u8Sense[KEYPAD_PORT_A] = PORTA & spKEYPAD_status->u8SenseMask[KEYPAD_PORT_A];
+    uint8 u8Any = u8Sense[KEYPAD_PORT_A];
 #ifdef PORTB
-    uint8 portB = PORTB;
+    u8Sense[KEYPAD_PORT_B] = PORTB & spKEYPAD_status->u8SenseMask[KEYPAD_PORT_B];
+    u8Any = u8Any | u8Sense[KEYPAD_PORT_B];
 #endif
 #ifdef PORTC
-    uint8 portC = PORTC;
+    u8Sense[KEYPAD_PORT_C] = PORTC & spKEYPAD_status->u8SenseMask[KEYPAD_PORT_C];
+    u8Any = u8Any | u8Sense[KEYPAD_PORT_C];
 #endif
-    // {^`FbN
-    uint16 u16PinMap;
-    uint8 u8Port;
+    u8Sense[KEYPAD_PORT_NONE] = 0x00;
+    // 入力の有無を判定
+    if (u8Any == 0x00) {
+        return 0x00;
+    }
+    // 列毎の入力をビットマップへ変換
+    uint8 u8ColBits = 0x00;
+    uint8 u8Bit = 0x01;
     uint8 u8Col;
     for (u8Col = 0; u8Col < KEYPAD_COL_SIZE; u8Col++) {
-        u16PinMap = spKEYPAD_status->u16PinCols[u8Col];
-        switch (u16PinMap & 0xFF00) {
-            case ID_PORTA:
-                u8Port = portA;
-                break;
+        if ((u8Sense[portIndex(spKEYPAD_status->u16PinCols[u8Col])]
+                & (uint8)spKEYPAD_status->u16PinCols[u8Col]) != 0x00) {
+            u8ColBits = u8ColBits | u8Bit;
+        }
+        u8Bit = u8Bit << 1;
+    }
+    return u8ColBits;
+}
+
+/*******************************************************************************
+ *
+ * NAME: portIndex
+ *
+ * DESCRIPTION:ピンマップのポート番号取得
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *      uint16      u16PinMap       R   ピンマップ（ID_PORTx | ピンのマスク）
+ *
+ * RETURNS:
+ *   uint8 ポート番号（KEYPAD_PORT_*）、対象外のポートはKEYPAD_PORT_NONE
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static uint8 portIndex(uint16 u16PinMap) {
+    switch (u16PinMap & 0xFF00) {
+        case ID_PORTA:
+            return KEYPAD_PORT_A;
+#ifdef PORTB
+        case ID_PORTB:
+            return KEYPAD_PORT_B;
+#endif
+#ifdef PORTC
+        case ID_PORTC:
+            return KEYPAD_PORT_C;
+#endif
+    }
+    return KEYPAD_PORT_NONE;
+}
+
+/*******************************************************************************
+ *
+ * NAME: readPort
+ *
+ * DESCRIPTION:ポートの読み込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *      uint8       u8Port          R   ポート番号（KEYPAD_PORT_*）
+ *
+ * RETURNS:
+ *   uint8 ポートの値
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static uint8 readPort(uint8 u8Port) {
+    switch (u8Port) {
 #ifdef PORTB
-            case ID_PORTB:
-                u8Port = portB;
-                break;
+        case KEYPAD_PORT_B:
+            return PORTB;
 #endif
 #ifdef PORTC
-            case ID_PORTC:
-                u8Port = portC;
-                break;
+        case KEYPAD_PORT_C:
+            return PORTC;
 #endif
-            default:
-                // ĂL[Ȃ
-                return 0xFF;
+    }
+    return PORTA;
+}
+
+/*******************************************************************************
+ *
+ * NAME: writePort
+ *
+ * DESCRIPTION:ポートへの書き込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *      uint8       u8Port          R   ポート番号（KEYPAD_PORT_*）
+ *      uint8       u8Value         R   書き込み値
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void writePort(uint8 u8Port, uint8 u8Value) {
+    switch (u8Port) {
+        case KEYPAD_PORT_A:
+            PORTA = u8Value;
+            break;
+#ifdef PORTB
+        case KEYPAD_PORT_B:
+            PORTB = u8Value;
+            break;
+#endif
+#ifdef PORTC
+        case KEYPAD_PORT_C:
+            PORTC = u8Value;
+            break;
+#endif
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: keyGhost
+ *
+ * DESCRIPTION:ゴーストの判定
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *      uint16      u16Map          R   走査したキー状態ビットマップ
+ *
+ * RETURNS:
+ *   bool_t         TRUE:ゴーストの可能性有り
+ *
+ * NOTES:
+ * ２つの行で２つ以上の列が共通して押下されている場合（矩形の４隅）は、
+ * いずれか１つがゴーストの可能性がある為、判定不能とする。
+ ******************************************************************************/
+static bool keyGhost(uint16 u16Map) {
+    // ２キー以下は矩形にならない
+    uint16 u16Work = u16Map & (u16Map - 1);
+    if ((u16Work & (u16Work - 1)) == 0x0000) {
+        return false;
+    }
+    // 行毎の列ビットマップを比較
+    uint8 u8Cols[KEYPAD_ROW_SIZE];
+    uint8 u8Common;
+    uint8 u8Row;
+    uint8 u8Prev;
+    for (u8Row = 0; u8Row < KEYPAD_ROW_SIZE; u8Row++) {
+        u8Cols[u8Row] = (uint8)u16Map & ((1 << KEYPAD_COL_SIZE) - 1);
+        u16Map = u16Map >> KEYPAD_COL_SIZE;
+        for (u8Prev = 0; u8Prev < u8Row; u8Prev++) {
+            u8Common = u8Cols[u8Row] & u8Cols[u8Prev];
+            if ((u8Common & (u8Common - 1)) != 0x00) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/*******************************************************************************
+ *
+ * NAME: keyUpdate
+ *
+ * DESCRIPTION:キー毎の状態遷移
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *      uint16      u16Raw          R   走査したキー状態ビットマップ
+ *
+ * RETURNS:
+ *   uint8 押下、長押し、リピートを検出したキー番号、検出無しの場合は0xFF
+ *
+ * NOTES:
+ * 走査結果が確定状態と異なるキーは、u8Debounce回（KEYPAD_DEBOUNCE_MAXまで）
+ * 連続した時点で押下又は解放を確定する（途中で戻った場合はチャタリングとして
+ * 破棄）。最後に押下したキーはu8RepeatDelay回で長押し、更にu8RepeatDelay回で
+ * リピートを通知し、以降の
+ * リピート間隔はu8RepeatAccelずつu8RepeatRateまで短縮する。
+ ******************************************************************************/
+static uint8 keyUpdate(uint16 u16Raw) {
+    uint8 u8Result = 0xFF;
+    uint8 u8KeyNo;
+    uint8 u8Cnt;
+    // 判定回数は4bitで保持する為、上限で制限する
+    uint8 u8Debounce = spKEYPAD_status->u8Debounce;
+    if (u8Debounce > KEYPAD_DEBOUNCE_MAX) {
+        u8Debounce = KEYPAD_DEBOUNCE_MAX;
+    }
+    // 確定状態と異なるキーと判定中のキーを対象とする
+    uint16 u16Diff = u16Raw ^ spKEYPAD_status->u16Pressed;
+    uint16 u16Work = u16Diff | spKEYPAD_status->u16Pending;
+    uint16 u16Bit  = 0x0001;
+    uint8 u8Idx    = 0;
+    while (u16Work != 0x0000) {
+        if ((u16Work & 0x0001) != 0x0000) {
+            u8Cnt = keyCount(u8Idx) + 1;
+            if ((u16Diff & u16Bit) == 0x0000) {
+                // 確定状態に戻ったキー（チャタリング）
+                keySetCount(u8Idx, 0);
+                spKEYPAD_status->u16Pending &= ~u16Bit;
+            } else if (u8Cnt < u8Debounce) {
+                // 判定中
+                keySetCount(u8Idx, u8Cnt);
+                spKEYPAD_status->u16Pending |= u16Bit;
+            } else {
+                // 押下又は解放の確定
+                keySetCount(u8Idx, 0);
+                spKEYPAD_status->u16Pending &= ~u16Bit;
+                spKEYPAD_status->u16Pressed ^= u16Bit;
+                u8KeyNo = u8Idx;       // キー番号はビット位置（行 * KEYPAD_COL_SIZE + 列）
+                if ((spKEYPAD_status->u16Pressed & u16Bit) != 0x0000) {
+                    // 押下イベント（リピート対象を切り替え）
+                    keyEvent(u8KeyNo, KEYPAD_EVT_PRESS);
+                    spKEYPAD_status->u8RepeatIdx   = u8Idx;
+                    spKEYPAD_status->u8RepeatCnt   = 0;
+                    spKEYPAD_status->u8RepeatIntvl = spKEYPAD_status->u8RepeatDelay;
+                    spKEYPAD_status->bRepeating    = false;
+                    u8Result = u8KeyNo;
+                } else {
+                    // 解放イベント
+                    keyEvent(u8KeyNo, KEYPAD_EVT_RELEASE);
+                    if (spKEYPAD_status->u8RepeatIdx == u8Idx) {
+                        spKEYPAD_status->u8RepeatIdx = 0xFF;
+                    }
+                }
+            }
         }
-        // ͔
-        if ((u8Port & (uint8)u16PinMap) != 0x00) {
-            return u8Col;
+        u16Work = u16Work >> 1;
+        u16Bit  = u16Bit << 1;
+        u8Idx++;
+    }
+    // 長押しとリピートの判定（押下を確定した回は判定しない）
+    u8Idx = spKEYPAD_status->u8RepeatIdx;
+    if (u8Idx == 0xFF || u8Result != 0xFF) {
+        return u8Result;
+    }
+    if (++spKEYPAD_status->u8RepeatCnt < spKEYPAD_status->u8RepeatIntvl) {
+        return u8Result;
+    }
+    spKEYPAD_status->u8RepeatCnt = 0;
+    u8KeyNo = u8Idx;
+    if (!spKEYPAD_status->bRepeating) {
+        // 長押しイベント（次のリピートまでは同じ間隔）
+        keyEvent(u8KeyNo, KEYPAD_EVT_LONG);
+        spKEYPAD_status->bRepeating = true;
+    } else {
+        // リピートイベント（間隔を短縮）
+        keyEvent(u8KeyNo, KEYPAD_EVT_REPEAT);
+        uint8 u8Intvl = spKEYPAD_status->u8RepeatIntvl;
+        uint8 u8Rate  = spKEYPAD_status->u8RepeatRate;
+        if (u8Intvl > u8Rate && u8Intvl - u8Rate > spKEYPAD_status->u8RepeatAccel) {
+            spKEYPAD_status->u8RepeatIntvl = u8Intvl - spKEYPAD_status->u8RepeatAccel;
+        } else {
+            spKEYPAD_status->u8RepeatIntvl = u8Rate;
         }
     }
-    // ĂL[Ȃ
-    return 0xFF;
+    return u8KeyNo;
+}
+
+/*******************************************************************************
+ *
+ * NAME: keyCount
+ *
+ * DESCRIPTION:キー毎の判定回数の取得
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *      uint8       u8Idx           R   キー番号
+ *
+ * RETURNS:
+ *   uint8 判定回数
+ *
+ * NOTES:
+ * ２キー分の判定回数を１バイトに保持する（偶数キーは下位、奇数キーは上位4bit）。
+ ******************************************************************************/
+static uint8 keyCount(uint8 u8Idx) {
+    uint8 u8Val = spKEYPAD_status->u8KeyCnt[u8Idx >> 1];
+    if ((u8Idx & 0x01) != 0x00) {
+        u8Val = u8Val >> 4;
+    }
+    return u8Val & 0x0F;
+}
+
+/*******************************************************************************
+ *
+ * NAME: keySetCount
+ *
+ * DESCRIPTION:キー毎の判定回数の設定
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *      uint8       u8Idx           R   キー番号
+ *      uint8       u8Cnt           R   判定回数（KEYPAD_DEBOUNCE_MAXまで）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void keySetCount(uint8 u8Idx, uint8 u8Cnt) {
+    uint8 *pu8Val = &spKEYPAD_status->u8KeyCnt[u8Idx >> 1];
+    if ((u8Idx & 0x01) != 0x00) {
+        *pu8Val = (*pu8Val & 0x0F) | (uint8)(u8Cnt << 4);
+    } else {
+        *pu8Val = (*pu8Val & 0xF0) | u8Cnt;
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: keyEvent
+ *
+ * DESCRIPTION:キーイベントの通知
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *      uint8       u8KeyNo         R   キー番号
+ *      uint8       u8Type          R   イベント種別（KEYPAD_EVT_*）
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 通知先が未登録の場合は未読イベントとして保持する。
+ ******************************************************************************/
+static void keyEvent(uint8 u8KeyNo, uint8 u8Type) {
+    if (spKEYPAD_status->pvCallback != NULL) {
+        spKEYPAD_status->pvCallback(u8KeyNo, u8Type);
+        return;
+    }
+    spKEYPAD_status->u8EventKeyNo = u8KeyNo;
+    spKEYPAD_status->u8EventType  = u8Type;
 }
 
 /******************************************************************************/
@@ -21,7 +21,7 @@
 /***       Include files                                                    ***/
 /******************************************************************************/
 #include <xc.h>
-#include "libcom.h"           // ʒ`
+#include "libcom.h"           // 共通定義
 
 /******************************************************************************/
 /***       Macro Definitions                                                ***/
@@ -42,8 +42,10 @@
 /******************************************************************************/
 /***        Local Variables                                                 ***/
 /******************************************************************************/
-/** NeBJZNV̊KwJE^ */
+/** クリティカルセクションの階層カウンタ */
 static volatile uint8 u8Depth = 0;
+/** クリティカルセクション開始前の割り込み許可状態 */
+static volatile bool bGieSave = false;
 
 /******************************************************************************/
 /***        Exported Functions                                              ***/
@@ -53,17 +55,22 @@ static volatile uint8 u8Depth = 0;
  *
  * NAME: criticalSec_vBegin
  *
- * DESCRIPTION:NeBJZNV̊Jn
+ * DESCRIPTION:クリティカルセクションの開始
  *
  * PARAMETERS:  Name            RW  Usage
  *
  * RETURNS:
  *
  * NOTES:
- * None.
+ * 最も外側の開始時にGIEの状態を保存し、終了時に元の状態へ戻す。
+ * 割り込み処理（GIE=0）の中から呼び出しても割り込みを許可しない。
  ******************************************************************************/
 extern void criticalSec_vBegin() {
+    bool bGie = GIE;
     GIE = 0;
+    if (u8Depth == 0) {
+        bGieSave = bGie;
+    }
     u8Depth++;
 }
 
@@ -71,7 +78,7 @@ extern void criticalSec_vBegin() {
  *
  * NAME: criticalSec_vEnd
  *
- * DESCRIPTION:NeBJZNV̏I
+ * DESCRIPTION:クリティカルセクションの終了
  *
  * PARAMETERS:  Name            RW  Usage
  *
@@ -82,11 +89,55 @@ extern void criticalSec_vBegin() {
  ******************************************************************************/
 extern void criticalSec_vEnd() {
     u8Depth--;
-    if (u8Depth == 0) {
+    if (u8Depth == 0 && bGieSave) {
         GIE = 1;
     }
 }
 
+/*******************************************************************************
+ *
+ * NAME: timer1_vInit
+ *
+ * DESCRIPTION:Timer1の初期化
+ *
+ * PARAMETERS:  Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * Timer1をフリーランで動作させる（動作中の場合は設定を変更しない）。
+ * 待ち時間の計測に共用する為、カウント値は書き換えないこと。
+ ******************************************************************************/
+extern void timer1_vInit() {
+    if (!T1CONbits.TMR1ON) {
+        T1CON = TIMER1_T1CON;
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: timer1_u16GetTick
+ *
+ * DESCRIPTION:Timer1のカウント値取得
+ *
+ * PARAMETERS:  Name            RW  Usage
+ *
+ * RETURNS:
+ *     uint16 Timer1のカウント値
+ *
+ * NOTES:
+ * 下位バイト読み出し中の桁上がりを考慮して上位バイトを再確認する。
+ ******************************************************************************/
+extern uint16 timer1_u16GetTick() {
+    uint8 u8High;
+    uint8 u8Low;
+    do {
+        u8High = TMR1H;
+        u8Low  = TMR1L;
+    } while (u8High != TMR1H);
+    return ((uint16)u8High << 8) | u8Low;
+}
+
 /******************************************************************************/
 /***        Local Functions                                                 ***/
 /******************************************************************************/
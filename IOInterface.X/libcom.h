@@ -32,7 +32,7 @@ extern "C" {
 /***        Macro Definitions                                               ***/
 /******************************************************************************/
 
-// {f[^^̒`
+// 基本データ型の定義
 #define bool   unsigned char
 #define int8   char
 #define int16  int
@@ -41,14 +41,27 @@ extern "C" {
 #define uint16 unsigned int
 #define uint32 unsigned long
 
-// u[l
+// ブール値
 #define true  (1)
 #define false (0) 
 // ON/OFF
 #define ON  (1)
 #define OFF (0) 
 
-// |[g̎ʎq
+// Timer1の設定（Fosc/4、プリスケーラ1:8、動作開始）
+#ifndef TIMER1_T1CON
+#define TIMER1_T1CON    (0b00110001)
+#endif
+// Timer1のプリスケーラ値（TIMER1_T1CONの設定と合わせる）
+#ifndef TIMER1_PRESCALE
+#define TIMER1_PRESCALE (8)
+#endif
+// 時間（us単位）をTimer1のカウント数に換算（切り上げ、_XTAL_FREQの定義が必要）
+#define TIMER1_TICKS_US(us)     \
+    ((uint16)(((uint32)(us) * ((_XTAL_FREQ) / 1000000) + 4 * TIMER1_PRESCALE - 1) \
+        / (4 * TIMER1_PRESCALE)))
+
+// ポートの識別子
 #ifdef PORTA
 #define ID_PORTA  (0x0000)
 #endif
@@ -78,10 +91,14 @@ extern "C" {
 /******************************************************************************/
 /***        Exported Functions                                              ***/
 /******************************************************************************/
-/** NeBJZNV̊Jn */
+/** クリティカルセクションの開始 */
 extern void criticalSec_vBegin();
-/** NeBJZNV̏I */
+/** クリティカルセクションの終了 */
 extern void criticalSec_vEnd();
+/** Timer1の初期化 */
+extern void timer1_vInit();
+/** Timer1のカウント値取得 */
+extern uint16 timer1_u16GetTick();
 
 #ifdef	__cplusplus
 }
@@ -32,10 +32,12 @@ extern "C" {
 /******************************************************************************/
 /***        Macro Definitions                                               ***/
 /******************************************************************************/
-// gݒ
-#define _XTAL_FREQ  16000000    // delaypɕKv(NbN16MHzw)
+// 周波数設定
+#define _XTAL_FREQ  16000000    // delay用に必要(クロック16MHzを指定)
 // I2C Adress
 #define	I2C_ADDR    (0x08)
+// LCDシャドウ表示データの桁数（16桁x2行のLCD）
+#define ST7032_SHADOW_COL_SIZE  (16)
 
 
 /******************************************************************************/
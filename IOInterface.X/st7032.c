@@ -21,77 +21,161 @@
 /***        Include files                                                   ***/
 /******************************************************************************/
 #include <xc.h>
-#include "setting.h"            // ݒl
-#include "libcom.h"             // ʒ`
-#include "st7032.h"             // LCDCu
-#include "i2cUtil.h"            // I2C֐Cup
+#include "setting.h"            // 設定値
+#include "libcom.h"             // 共通定義
+#include "st7032.h"             // LCDライブラリ
+#include "i2cUtil.h"            // I2C関数ライブラリ用
 
 /******************************************************************************/
 /***        Macro Definitions                                               ***/
 /******************************************************************************/
-// Address Read/Write
-#define ST7032_I2C_ADDR             (0x3E)
-
-// Rg[oCgiR}hj
+// コントロールバイト（コマンド）
 #define ST7032_CNTR_CMD             (0x00)
-// Rg[oCgif[^j
+// コントロールバイト（データ）
 #define ST7032_CNTR_DATA            (0x40)
+// コントロールバイト（継続ビット：Co）
+#define ST7032_CNTR_CO              (0x80)
+
+// ST7032インストラクション
+#define ST7032_CMD_CLEAR_DISP       (0b00000001)    // クリアディスプレイ
+#define ST7032_CMD_ENTRY_MODE_SET   (0b00000100)    // 入力モード設定
+#define ST7032_CMD_DISP_CNTR_DEF    (0b00001000)    // ディスプレイ設定
+#define ST7032_CMD_OSC_FREQ         (0b00010100)    // 内部オシレータ設定
+#define ST7032_CMD_FUNC_SET_DEF     (0b00111000)    // ファンクション設定　IS(instruction table select)＝0
+#define ST7032_CMD_FUNC_SET_EX      (0b00111001)    // ファンクション設定　IS(instruction table select)＝1
+#define ST7032_CMD_DISP_CNTR_EX     (0b01011000)    // 拡張ディスプレイ設定、アイコン表示ON、ブースター回路OFF、コントラスト設定（上2桁）
+#define ST7032_CMD_FOLLOWER_CNTR    (0b01101100)    // フォロア回路ON、Rab0?Rab2(0b100)
+#define ST7032_CMD_CONTRAST_LOW     (0b01110000)    // コントラスト設定（下4桁）
+#define ST7032_CMD_SET_CGRAM        (0b01000000)    // CGRAMアドレス設定
+#define ST7032_CMD_SET_ICON_ADDR    (0b01000000)    // アイコンアドレス設定
+#define ST7032_CMD_SET_DD_ADDR      (0b10000000)    // カーソルアドレス設定
+#define ST7032_CMD_RETURN_HOME      (0b00000010)    // リターンホーム
+
+// 初期設定値（ICON表示ON、ブースター回路ON、コントラスト0x28）
+#define ST7032_INIT_SETTINGS        (0xE8)
+// 初期ディスプレイ設定（表示ON、カーソル表示OFF、カーソル点滅OFF）
+#define ST7032_INIT_DISP_CNTR       (ST7032_CMD_DISP_CNTR_DEF | 0x04)
+
+// アドレスカウンタの対象
+#define ST7032_ADDR_DDRAM           (0x00)          // DDRAM
+#define ST7032_ADDR_CGRAM           (0x01)          // CGRAM
+#define ST7032_ADDR_ICON            (0x02)          // ICON RAM
+// 状態不明
+#define ST7032_STATE_UNKNOWN        (0xFF)
 
-// ST7032CXgNV
-#define ST7032_CMD_CLEAR_DISP       (0b00000001)    // NAfBXvC
-#define ST7032_CMD_ENTRY_MODE_SET   (0b00000100)    // ̓[hݒ
-#define ST7032_CMD_DISP_CNTR_DEF    (0b00001000)    // fBXvCݒ
-#define ST7032_CMD_OSC_FREQ         (0b00010100)    // IV[^ݒ
-#define ST7032_CMD_FUNC_SET_DEF     (0b00111000)    // t@NVݒ@IS(instruction table select)0
-#define ST7032_CMD_FUNC_SET_EX      (0b00111001)    // t@NVݒ@IS(instruction table select)1
-#define ST7032_CMD_DISP_CNTR_EX     (0b01011000)    // gfBXvCݒAACR\ONAu[X^[HOFFARgXgݒi2j
-#define ST7032_CMD_FOLLOWER_CNTR    (0b01101100)    // tHAHONARab0?Rab2(0b100)
-#define ST7032_CMD_CONTRAST_LOW     (0b01110000)    // RgXgݒi4j
-#define ST7032_CMD_SET_CGRAM        (0b01000000)    // CGRAMAhXݒ
-#define ST7032_CMD_SET_ICON_ADDR    (0b01000000)    // ACRAhXݒ
-#define ST7032_CMD_SET_DD_ADDR      (0b10000000)    // J[\AhXݒ
-
-// ҂
-#ifndef ST7032_DEF_WAIT
-#define ST7032_DEF_WAIT             (26)
+// 待ち時間
+#ifndef ST7032_EXEC_TIME
+#define ST7032_EXEC_TIME            (263)   // 標準の命令実行時間（0.1us単位）
+#endif
+#ifndef ST7032_PACE_UNIT
+#define ST7032_PACE_UNIT            (2)     // 待ち時間の単位（us）
 #endif
 #ifndef ST7032_EX_WAIT
 #define ST7032_EX_WAIT              (1080)
 #endif
 
+// 更新ランの結合間隔（未変更セル数がアドレス設定のバイト数以下なら結合して送信）
+#ifndef ST7032_RUN_GAP_MAX
+#define ST7032_RUN_GAP_MAX          (4)
+#endif
+// 空白文字（クリアディスプレイ後のDDRAMの値）
+#define ST7032_CHAR_SPACE           (0x20)
+
+// クロック周波数（MHz）
+#define ST7032_FOSC_MHZ             (_XTAL_FREQ / 1000000)
+// 実行時間（0.1us単位）をTimer1のカウント数に換算（切り上げ）
+#define ST7032_TICKS(time)          \
+    ((uint16)(((uint32)(time) * ST7032_FOSC_MHZ + 40 * TIMER1_PRESCALE - 1) \
+        / (40 * TIMER1_PRESCALE)))
+// 標準の命令実行時間（Timer1カウント数）
+#define ST7032_EXEC_TICKS           ST7032_TICKS(ST7032_EXEC_TIME)
+// クリアディスプレイの実行時間（Timer1カウント数）
+#define ST7032_EX_TICKS             ST7032_TICKS(ST7032_EX_WAIT * 10)
+// 1バイトのワイヤ時間（0.1us単位）＝ 9クロック x 4 x (SSPxADD + 1) / Fosc
+#define ST7032_WIRE_TIME(baud)      ((uint16)((baud) + 1) * 360 / ST7032_FOSC_MHZ)
+// 待ち時間が不要となるSSPxADDの最小値（ワイヤ時間≧命令実行時間）
+#define ST7032_PACE_BAUD_MIN        \
+    ((ST7032_EXEC_TIME * ST7032_FOSC_MHZ + 359) / 360 - 1)
+
 /******************************************************************************/
 /***        Type Definitions                                                ***/
 /******************************************************************************/
-/**
- * \́FLCD̏ԏ
- */
-typedef struct {
-	// J[\ʒu
-	uint8 u8CursorPos;
-    // ICON display(1bit). booster circuit(1bit). Contrast(6bit).
-	uint8 u8Settings;
-} ST7032_state;
 
 /******************************************************************************/
 /***        Local Function Prototypes                                       ***/
 /******************************************************************************/
+// Wait ready and send start condition
+static void vStart(tsST7032_handle *psHandle);
+// Wait ready
+static void vWaitReady(tsST7032_handle *psHandle);
+
+// Send command list (Co=1)
+static void vSendList(tsST7032_handle *psHandle, const uint8* pu8List, uint8 u8Cnt);
+
+// Set DDRAM address
+static void vSetDDAddr(tsST7032_handle *psHandle, uint8 u8Pos);
+
+// Restore cursor
+static void vRestoreCursor(tsST7032_handle *psHandle);
+
+// Select instruction table
+static void vSelectTable(tsST7032_handle *psHandle, uint8 u8FuncSet);
+
+// Set CGRAM/ICON RAM address
+static void vSetAddr(tsST7032_handle *psHandle, uint8 u8Mode, uint8 u8Addr);
+
 // Execute Command
-static void vExecCmdSSP1(uint8 u8Cmd);
-#ifdef SSP2STAT
-static void vExecCmdSSP2(uint8 u8Cmd);
-#endif
+static void vExecCmd(tsST7032_handle *psHandle, uint8 u8Cmd);
 
 // Execute Command and Stop End
-static void vExecCmdEndSSP1(uint8 u8Cmd);
-#ifdef SSP2STAT
-static void vExecCmdEndSSP2(uint8 u8Cmd);
-#endif
+static void vExecCmdEnd(tsST7032_handle *psHandle, uint8 u8Cmd);
 
 // Move cursor
-static bool bSetCursorSSP1(uint8 u8Pos);
+static bool bSetCursor(tsST7032_handle *psHandle, uint8 u8Pos);
+
+// Write shadow run
+static void vWriteRun(tsST7032_handle *psHandle, uint8 u8Idx, uint8 u8Len);
+
+// Convert cursor position to DDRAM address command
+static uint8 u8SetDDAddrCmd(uint8 u8Pos);
+
+// Reset cached controller state
+static void vResetCache(tsST7032_handle *psHandle);
+// Invalidate cached controller state and shadow
+static void vInvalidate(tsST7032_handle *psHandle);
+// Check cursor restore
+static bool bNeedRestore(tsST7032_handle *psHandle);
+
+// Set busy period
+static void vSetBusy(tsST7032_handle *psHandle, uint16 u16Ticks);
+
+// Calculate pace count
+static uint8 u8CalcPaceCnt(uint8 u8Baud);
+// Wait for instruction execution
+static void vPace(uint8 u8Cnt);
+
+// Clear shadow
+static void vClearShadow(tsST7032_handle *psHandle);
+// Set shadow
+static bool bSetShadow(tsST7032_handle *psHandle,
+        uint8 u8RowNo, uint8 u8ColNo, uint8* pu8Data, uint8 u8Len);
+// Synchronize shadow with written data
+static void vSyncShadow(tsST7032_handle *psHandle, uint8* pu8Data, uint8 u8Len);
+// Search dirty run
+static uint8 u8SearchRun(tsST7032_handle *psHandle, uint8* pu8Idx);
+// Set dirty flags
+static void vSetDirty(tsST7032_handle *psHandle, uint8 u8Idx, uint8 u8Len, bool bDirty);
+
 #ifdef SSP2STAT
-static bool bSetCursorSSP2(uint8 u8Pos);
+// Submit shadow run
+static void vSubmitRun(tsST7032_handle *psHandle, uint8 u8Idx, uint8 u8Len);
+// Submit cursor restore
+static void vSubmitRestore(tsST7032_handle *psHandle);
+// Flush transaction completion
+static void vFlushDone(tsI2C_MstTrans *psTrans);
 #endif
+// Wait flush completion
+static void vWaitFlush(tsST7032_handle *psHandle);
 
 /******************************************************************************/
 /***        Exported Variables                                              ***/
@@ -100,12 +184,30 @@ static bool bSetCursorSSP2(uint8 u8Pos);
 /******************************************************************************/
 /***        Local Variables                                                 ***/
 /******************************************************************************/
-/** J[\ʒu(SSP1) */
-static ST7032_state stStateSSP1;
-/** J[\ʒu(SSP2) */
-#ifdef SSP2STAT
-static ST7032_state stStateSSP2;
-#endif
+/** 初期化コマンドリスト */
+static const uint8 u8InitList[] = {
+    // ファンクション設定　IS(instruction table select)＝1
+    ST7032_LIST_CMD, ST7032_CMD_FUNC_SET_EX,
+    // 内部オシレータ設定
+    ST7032_LIST_CMD, ST7032_CMD_OSC_FREQ,
+    // コントラスト設定（下4桁）
+    ST7032_LIST_CMD, ST7032_CMD_CONTRAST_LOW | (ST7032_INIT_SETTINGS & 0x0F),
+    // 拡張ディスプレイ設定、アイコン表示ON、ブースター回路ON、コントラスト設定（上2桁）
+    ST7032_LIST_CMD, ST7032_CMD_DISP_CNTR_EX | (ST7032_INIT_SETTINGS >> 4),
+    // フォロア回路ON、Rab0?Rab2(0b100)
+    ST7032_LIST_CMD, ST7032_CMD_FOLLOWER_CNTR,
+    // ファンクション設定　IS(instruction table select)＝0
+    ST7032_LIST_CMD, ST7032_CMD_FUNC_SET_DEF,
+    // ディスプレイ設定、表示ON、カーソル表示OFF、カーソル点滅OFF
+    ST7032_LIST_CMD, ST7032_CMD_DISP_CNTR_DEF | 0x04,
+    // 入力モード設定、アドレスインクリメント
+    ST7032_LIST_CMD, ST7032_CMD_ENTRY_MODE_SET | 0x02,
+    // カーソル設定
+    ST7032_LIST_CMD, ST7032_CMD_SET_DD_ADDR,
+    // クリアディスプレイ
+    ST7032_LIST_CMD, ST7032_CMD_CLEAR_DISP
+};
+
 
 
 /******************************************************************************/
@@ -113,11 +215,14 @@ static ST7032_state stStateSSP2;
 /******************************************************************************/
 /*******************************************************************************
  *
- * NAME: ST7032_vInitSSP1
+ * NAME: ST7032_vInit
  *
  * DESCRIPTION:Initialize LCD
  *
  * PARAMETERS:      Name            RW  Usage
+ * tsST7032_handle* psHandle        W   LCDハンドル
+ * tsI2C_Bus*       psBus           R   I2Cバス記述子（I2C_BUS_SSP1/I2C_BUS_SSP2）
+ *       uint8      u8Address       R   I2Cアドレス（通常はST7032_I2C_ADDR）
  *
  * RETURNS:
  *
@@ -125,49 +230,59 @@ static ST7032_state stStateSSP2;
  * None.
  * 
  ******************************************************************************/
-extern void ST7032_vInitSSP1() {
-    // J[\ʒu
-    stStateSSP1.u8CursorPos = 0x00;
+extern void ST7032_vInit(tsST7032_handle *psHandle, const tsI2C_Bus *psBus,
+                         uint8 u8Address) {
+#ifdef SSP2STAT
+    // 再初期化の場合は非同期送信の完了待ち
+    if (psBus == I2C_BUS_SSP2) {
+        I2C_vMstDrainSSP2();
+    }
+#endif
+    // 接続先
+    psHandle->psBus     = psBus;
+    psHandle->u8Address = u8Address;
+    // 非同期送信のトランザクション記述子
+    psHandle->sTrans.u8Address  = u8Address;
+    psHandle->sTrans.pu8RxData  = NULL;
+    psHandle->sTrans.u8RxLen    = 0;
+#ifdef SSP2STAT
+    psHandle->sTrans.pvCallback = vFlushDone;
+#endif
+    psHandle->u8TxHead[2] = ST7032_CNTR_DATA;
+    psHandle->bFlushing   = false;
+    // カーソル位置
+    psHandle->u8CursorPos = 0x00;
     // ICON,Booster,Contrast
-    stStateSSP1.u8Settings = 0xE8;
-    // X^[gRfBV̑M
-    I2C_u8MstStartSSP1(ST7032_I2C_ADDR, false);
-    // t@NVݒ@IS(instruction table select)1
-    vExecCmdSSP1(ST7032_CMD_FUNC_SET_EX);
-    __delay_us(ST7032_DEF_WAIT);
-    // IV[^ݒ
-    vExecCmdSSP1(ST7032_CMD_OSC_FREQ);
-    __delay_us(ST7032_DEF_WAIT);
-    // RgXgݒi4j
-    vExecCmdSSP1(ST7032_CMD_CONTRAST_LOW | (stStateSSP1.u8Settings & 0x0F));
-    __delay_us(ST7032_DEF_WAIT);
-    // gfBXvCݒAACR\ONAu[X^[HONARgXgݒi2j
-    vExecCmdSSP1(ST7032_CMD_DISP_CNTR_EX | (stStateSSP1.u8Settings >> 4));
-    __delay_us(ST7032_DEF_WAIT);
-    // tHAHONARab0?Rab2(0b100)
-    vExecCmdSSP1(ST7032_CMD_FOLLOWER_CNTR);
-    __delay_us(ST7032_DEF_WAIT);
-    // t@NVݒ@IS(instruction table select)0
-    vExecCmdSSP1(ST7032_CMD_FUNC_SET_DEF);
-    __delay_us(ST7032_DEF_WAIT);
-    // fBXvCݒA\ONAJ[\\OFFAJ[\_OFF
-    vExecCmdSSP1(ST7032_CMD_DISP_CNTR_DEF | 0x04);
-    __delay_us(ST7032_DEF_WAIT);
-    // J[\ݒ
-    vExecCmdSSP1(ST7032_CMD_SET_DD_ADDR);
-    __delay_us(ST7032_DEF_WAIT);
-    // NAfBXvC
-    vExecCmdEndSSP1(ST7032_CMD_CLEAR_DISP);
-    __delay_us(ST7032_EX_WAIT);
+    psHandle->u8Settings = ST7032_INIT_SETTINGS;
+    // ボーレートから待ち回数を算出
+    psHandle->u8PaceCnt = u8CalcPaceCnt(*psBus->pu8Add);
+    // 実行時間計測用タイマーの初期化
+    timer1_vInit();
+    psHandle->u16BusyEnd = timer1_u16GetTick();
+    // 初期化コマンドリストの実行（クリアディスプレイまで）
+    ST7032_vExecList(psHandle, u8InitList, sizeof(u8InitList) / 2);
+    // 初期化後のコントローラの状態
+    psHandle->u8FuncSet  = ST7032_CMD_FUNC_SET_DEF;
+    psHandle->u8DispCntr = ST7032_INIT_DISP_CNTR;
+    psHandle->u8AddrMode = ST7032_ADDR_DDRAM;
+    psHandle->u8Addr     = 0x00;
+    // シャドウ表示データの初期化
+    vClearShadow(psHandle);
+    // 初期化に失敗した場合はコントローラの状態と表示内容を不明とする
+    if (I2C_bMstError(psBus)) {
+        vInvalidate(psHandle);
+    }
 }
 
 /*******************************************************************************
  *
- * NAME: ST7032_vInitSSP2
+ * NAME: ST7032_vSetContrast
  *
- * DESCRIPTION:Initialize LCD
+ * DESCRIPTION:LCD Contrast Setting
  *
  * PARAMETERS:      Name            RW  Usage
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ *        uint8     u8Contrast      R   Display Contrast
  *
  * RETURNS:
  *
@@ -175,54 +290,33 @@ extern void ST7032_vInitSSP1() {
  * None.
  * 
  ******************************************************************************/
-#ifdef SSP2STAT
-extern void ST7032_vInitSSP2() {
-    // J[\ʒu
-    stStateSSP2.u8CursorPos = 0x00;
-    // ICON,Booster,Contrast
-    stStateSSP2.u8Settings = 0xE8;
-    // X^[gRfBV̑M
-    I2C_u8MstStartSSP2(ST7032_I2C_ADDR, false);
-    // t@NVݒ@IS(instruction table select)1
-    vExecCmdSSP2(ST7032_CMD_FUNC_SET_EX);
-    __delay_us(ST7032_DEF_WAIT);
-    // IV[^ݒ
-    vExecCmdSSP2(ST7032_CMD_OSC_FREQ);
-    __delay_us(ST7032_DEF_WAIT);
-    // RgXgݒi4j
-    vExecCmdSSP2(ST7032_CMD_CONTRAST_LOW | (stStateSSP2.u8Settings & 0x0F));
-    __delay_us(ST7032_DEF_WAIT);
-    // gfBXvCݒAACR\ONAu[X^[HONARgXgݒi2j
-    vExecCmdSSP2(ST7032_CMD_DISP_CNTR_EX | (stStateSSP2.u8Settings >> 4));
-    __delay_us(ST7032_DEF_WAIT);
-    // tHAHONARab0?Rab2(0b100)
-    vExecCmdSSP2(ST7032_CMD_FOLLOWER_CNTR);
-    __delay_us(ST7032_DEF_WAIT);
-    // t@NVݒ@IS(instruction table select)0
-    vExecCmdSSP2(ST7032_CMD_FUNC_SET_DEF);
-    __delay_us(ST7032_DEF_WAIT);
-    // fBXvCݒA\ONAJ[\\OFFAJ[\_OFF
-    vExecCmdSSP2(ST7032_CMD_DISP_CNTR_DEF | 0x04);
-    __delay_us(ST7032_DEF_WAIT);
-    vExecCmdSSP2(ST7032_CMD_ENTRY_MODE_SET | 0x02);
-    __delay_us(ST7032_DEF_WAIT);
-    // J[\ݒ
-    vExecCmdSSP2(ST7032_CMD_SET_DD_ADDR);
-    __delay_us(ST7032_DEF_WAIT);
-    // NAfBXvC
-    vExecCmdEndSSP2(ST7032_CMD_CLEAR_DISP);
-    __delay_us(ST7032_EX_WAIT);
+extern void ST7032_vSetContrast(tsST7032_handle *psHandle, uint8 u8Contrast) {
+    // 入力チェック
+    uint8 u8Val = u8Contrast & 0x3F;
+    if ((psHandle->u8Settings & 0x3F) == u8Val) {
+        return;
+    }
+    // 設定更新
+    psHandle->u8Settings = (psHandle->u8Settings & 0xC0) | u8Val;
+    // スタートコンディションの送信
+    vStart(psHandle);
+    // ファンクション設定　IS(instruction table select)＝1
+    vSelectTable(psHandle, ST7032_CMD_FUNC_SET_EX);
+    // コントラスト設定（下4桁）
+    vExecCmd(psHandle, ST7032_CMD_CONTRAST_LOW | (psHandle->u8Settings & 0x0F));
+    vPace(psHandle->u8PaceCnt);
+    // 拡張ディスプレイ設定、アイコン表示ON、ブースター回路OFF、コントラスト設定（上2桁）
+    vExecCmdEnd(psHandle, ST7032_CMD_DISP_CNTR_EX | (psHandle->u8Settings >> 4));
 }
-#endif
 
 /*******************************************************************************
  *
- * NAME: ST7032_vSetContrastSSP1
+ * NAME: ST7032_vClearDisp
  *
- * DESCRIPTION:LCD Contrast Setting
+ * DESCRIPTION:Clear Display
  *
  * PARAMETERS:      Name            RW  Usage
- *        uint8     u8Contrast      R   Display Contrast
+ * tsST7032_handle* psHandle       RW  LCDハンドル
  *
  * RETURNS:
  *
@@ -230,38 +324,66 @@ extern void ST7032_vInitSSP2() {
  * None.
  * 
  ******************************************************************************/
-extern void ST7032_vSetContrastSSP1(uint8 u8Contrast) {
-    // ̓`FbN
-    uint8 u8Val = u8Contrast & 0x3F;
-    if ((stStateSSP1.u8Settings & 0x3F) == u8Val) {
-        return;
+extern void ST7032_vClearDisp(tsST7032_handle *psHandle) {
+    // スタートコンディションの送信
+    vStart(psHandle);
+    // LCDクリア
+    vExecCmdEnd(psHandle, ST7032_CMD_CLEAR_DISP);
+    // カーソル位置とアドレスカウンタの初期化
+    psHandle->u8CursorPos = 0;
+    psHandle->u8AddrMode  = ST7032_ADDR_DDRAM;
+    psHandle->u8Addr      = 0;
+    // クリアディスプレイの完了予定時刻
+    vSetBusy(psHandle, ST7032_EX_TICKS);
+    // シャドウ表示データの初期化
+    vClearShadow(psHandle);
+}
+
+/*******************************************************************************
+ *
+ * NAME: ST7032_vClearIcon
+ *
+ * DESCRIPTION:Clear Icon
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ * 
+ ******************************************************************************/
+extern void ST7032_vClearIcon(tsST7032_handle *psHandle) {
+    // スタートコンディションの送信
+    vStart(psHandle);
+    // アイコンアドレス設定
+    vSetAddr(psHandle, ST7032_ADDR_ICON, 0x00);
+    // コントロールバイト（データ）の送信
+    I2C_u8MstTx(psHandle->psBus, ST7032_CNTR_DATA);
+    // データの送信
+    uint8 u8Addr;
+    for (u8Addr = 0x00; u8Addr < 0x10; u8Addr++) {
+        I2C_u8MstTx(psHandle->psBus, 0x00);
+        vPace(psHandle->u8PaceCnt);
     }
-    // ݒXV
-    stStateSSP1.u8Settings = (stStateSSP1.u8Settings & 0xC0) | u8Val;
-    // X^[gRfBV̑M
-    I2C_u8MstStartSSP1(ST7032_I2C_ADDR, false);
-    // t@NVݒ@IS(instruction table select)1
-    vExecCmdSSP1(ST7032_CMD_FUNC_SET_EX);
-    __delay_us(ST7032_DEF_WAIT);
-    // RgXgݒi4j
-    vExecCmdSSP1(ST7032_CMD_CONTRAST_LOW | (stStateSSP1.u8Settings & 0x0F));
-    __delay_us(ST7032_DEF_WAIT);
-    // gfBXvCݒAACR\ONAu[X^[HOFFARgXgݒi2j
-    vExecCmdSSP1(ST7032_CMD_DISP_CNTR_EX | (stStateSSP1.u8Settings >> 4));
-    __delay_us(ST7032_DEF_WAIT);
-    // t@NVݒ@IS(instruction table select)0
-    vExecCmdEndSSP1(ST7032_CMD_FUNC_SET_DEF);
-    __delay_us(ST7032_DEF_WAIT);
+    // ストップビット;
+    I2C_vMstStop(psHandle->psBus);
+    // アイコンRAM末尾を超えた後のアドレスは不定
+    psHandle->u8Addr = ST7032_STATE_UNKNOWN;
+    // カーソル位置を戻す（カーソル表示中の場合のみ）
+    vRestoreCursor(psHandle);
 }
 
 /*******************************************************************************
  *
- * NAME: ST7032_vSetContrastSSP2
+ * NAME: ST7032_vDispIcon
  *
- * DESCRIPTION:LCD Contrast Setting
+ * DESCRIPTION:Icon Display Setting
  *
  * PARAMETERS:      Name            RW  Usage
- *        uint8     u8Contrast      R   Display Contrast
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ *        bool      bDisp           R   表示設定
  *
  * RETURNS:
  *
@@ -269,39 +391,32 @@ extern void ST7032_vSetContrastSSP1(uint8 u8Contrast) {
  * None.
  * 
  ******************************************************************************/
-#ifdef SSP2STAT
-extern void ST7032_vSetContrastSSP2(uint8 u8Contrast) {
-    // ̓`FbN
-    uint8 u8Val = u8Contrast & 0x3F;
-    if ((stStateSSP2.u8Settings & 0x3F) == u8Val) {
+extern void ST7032_vDispIcon(tsST7032_handle *psHandle, bool bDisp) {
+    // 更新判定
+    if ((psHandle->u8Settings >> 7) == bDisp) {
         return;
     }
-    // ݒXV
-    stStateSSP2.u8Settings = (stStateSSP2.u8Settings & 0xC0) | u8Val;
-    // X^[gRfBV̑M
-    I2C_u8MstStartSSP2(ST7032_I2C_ADDR, false);
-    // t@NVݒ@IS(instruction table select)1
-    vExecCmdSSP2(ST7032_CMD_FUNC_SET_EX);
-    __delay_us(ST7032_DEF_WAIT);
-    // RgXgݒi4j
-    vExecCmdSSP2(ST7032_CMD_CONTRAST_LOW | (stStateSSP2.u8Settings & 0x0F));
-    __delay_us(ST7032_DEF_WAIT);
-    // gfBXvCݒAACR\ONAu[X^[HOFFARgXgݒi2j
-    vExecCmdSSP2(ST7032_CMD_DISP_CNTR_EX | (stStateSSP2.u8Settings >> 4));
-    __delay_us(ST7032_DEF_WAIT);
-    // t@NVݒ@IS(instruction table select)0
-    vExecCmdEndSSP2(ST7032_CMD_FUNC_SET_DEF);
-    __delay_us(ST7032_DEF_WAIT);
+    // アイコン表示設定の更新
+    psHandle->u8Settings = (psHandle->u8Settings & 0x7F) | (bDisp << 7);
+    // スタートコンディションの送信
+    vStart(psHandle);
+    // ファンクション設定　IS(instruction table select)＝1
+    vSelectTable(psHandle, ST7032_CMD_FUNC_SET_EX);
+    // 拡張ディスプレイ設定、アイコン表示ON、ブースター回路ON、コントラスト設定（上2桁）
+    vExecCmdEnd(psHandle, ST7032_CMD_DISP_CNTR_EX | (psHandle->u8Settings >> 4));
 }
-#endif
 
 /*******************************************************************************
  *
- * NAME: ST7032_vClearDispSSP1
+ * NAME: ST7032_vDispSetting
  *
- * DESCRIPTION:Clear Display
+ * DESCRIPTION:LCD Setting
  *
  * PARAMETERS:      Name            RW  Usage
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ *        bool      bDisp           R   Display LCD
+ *        bool      bCursor         R   Cursor Display
+ *        bool      bBlink          R   Blink Cursor
  *
  * RETURNS:
  *
@@ -309,215 +424,155 @@ extern void ST7032_vSetContrastSSP2(uint8 u8Contrast) {
  * None.
  * 
  ******************************************************************************/
-extern void ST7032_vClearDispSSP1() {
-    // X^[gRfBV̑M
-    I2C_u8MstStartSSP1(ST7032_I2C_ADDR, false);
-    // LCDNA
-    vExecCmdEndSSP1(ST7032_CMD_CLEAR_DISP);
-    // J[\ʒȕ
-    stStateSSP1.u8CursorPos = 0;
-    __delay_us(ST7032_EX_WAIT);
+extern void ST7032_vDispSetting(tsST7032_handle *psHandle, bool bDisp, bool bCursor, bool bBlink) {
+    // 非同期送信の完了待ち（完了通知がディスプレイ設定を参照する為）
+    vWaitFlush(psHandle);
+    // 更新判定
+    uint8 u8Cmd = ST7032_CMD_DISP_CNTR_DEF | (bDisp << 2) | (bCursor << 1) | bBlink;
+    if (psHandle->u8DispCntr == u8Cmd) {
+        return;
+    }
+    psHandle->u8DispCntr = u8Cmd;
+    // スタートコンディションの送信
+    vStart(psHandle);
+    // カーソルを表示する場合はアドレスカウンタをカーソル位置へ移動
+    if (bNeedRestore(psHandle)) {
+        vSetDDAddr(psHandle, psHandle->u8CursorPos);
+    }
+    // ディスプレイ設定
+    vExecCmdEnd(psHandle, u8Cmd);
 }
 
 /*******************************************************************************
  *
- * NAME: ST7032_vClearDispSSP2
+ * NAME: ST7032_u8GetCursorRowNo
  *
- * DESCRIPTION:Clear Display
+ * DESCRIPTION:get cursor row no
  *
  * PARAMETERS:      Name            RW  Usage
+ * tsST7032_handle* psHandle       R   LCDハンドル
  *
  * RETURNS:
+ *    uint8 カーソル行
  *
  * NOTES:
  * None.
  * 
  ******************************************************************************/
-#ifdef SSP2STAT
-extern void ST7032_vClearDispSSP2() {
-    // X^[gRfBV̑M
-    I2C_u8MstStartSSP2(ST7032_I2C_ADDR, false);
-    // LCDNA
-    vExecCmdEndSSP2(ST7032_CMD_CLEAR_DISP);
-    // J[\ʒȕ
-    stStateSSP2.u8CursorPos = 0;
-    __delay_us(ST7032_EX_WAIT);
+extern uint8 ST7032_u8GetCursorRowNo(tsST7032_handle *psHandle) {
+    return psHandle->u8CursorPos / 40;
 }
-#endif
 
 /*******************************************************************************
  *
- * NAME: ST7032_vClearIconSSP1
+ * NAME: ST7032_u8GetCursorColNo
  *
- * DESCRIPTION:Clear Icon
+ * DESCRIPTION:get cursor column no
  *
  * PARAMETERS:      Name            RW  Usage
+ * tsST7032_handle* psHandle       R   LCDハンドル
  *
  * RETURNS:
+ *    uint8 カーソル列アドレス
  *
  * NOTES:
  * None.
  * 
  ******************************************************************************/
-extern void ST7032_vClearIconSSP1() {
-    // X^[gRfBV̑M
-    I2C_u8MstStartSSP1(ST7032_I2C_ADDR, false);
-	// CXgNVe[u`FWiIS=1j
-    vExecCmdSSP1(ST7032_CMD_FUNC_SET_EX);
-    __delay_us(ST7032_DEF_WAIT);
-	// R}h̑MiACRAhXj
-    vExecCmdSSP1(ST7032_CMD_SET_ICON_ADDR);
-    __delay_us(ST7032_DEF_WAIT);
-    // CXgNVe[u`FWiIS=0j
-    vExecCmdEndSSP1(ST7032_CMD_FUNC_SET_DEF);
-    __delay_us(ST7032_DEF_WAIT);
-    // X^[gRfBV̑M
-    I2C_u8MstStartSSP1(ST7032_I2C_ADDR, false);
-    // Rg[oCgif[^j̑M
-    I2C_u8MstTxSSP1(ST7032_CNTR_DATA);
-    // f[^̑M
-    uint8 u8Addr;
-    for (u8Addr = 0x00; u8Addr < 0x10; u8Addr++) {
-        I2C_u8MstTxSSP1(0x00);
-        __delay_us(ST7032_DEF_WAIT);
-    }
-    // Xgbvrbg;
-    I2C_vMstStopSSP1();
-    // J[\AhX֕ϊ
-    // X^[gRfBV̑M
-    I2C_u8MstStartSSP1(ST7032_I2C_ADDR, false);
-    // J[\ʒuĐݒ
-    bSetCursorSSP1(stStateSSP1.u8CursorPos);
+extern uint8 ST7032_u8GetCursorColNo(tsST7032_handle *psHandle) {
+    return psHandle->u8CursorPos % 40;
 }
 
 /*******************************************************************************
  *
- * NAME: ST7032_vClearIconSSP2
+ * NAME: ST7032_bSetCursor
  *
- * DESCRIPTION:Clear Icon
+ * DESCRIPTION:Move cursor
  *
  * PARAMETERS:      Name            RW  Usage
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ *       uint8      u8RowNo         R   Row No
+ *       uint8      u8ColNo         R   Column No
  *
  * RETURNS:
+ *     bool true:設定成功、false:設定失敗
  *
  * NOTES:
  * None.
  * 
  ******************************************************************************/
-#ifdef SSP2STAT
-extern void ST7032_vClearIconSSP2() {
-    // X^[gRfBV̑M
-    I2C_u8MstStartSSP2(ST7032_I2C_ADDR, false);
-	// CXgNVe[u`FWiIS=1j
-    vExecCmdSSP2(ST7032_CMD_FUNC_SET_EX);
-    __delay_us(ST7032_DEF_WAIT);
-	// R}h̑MiACRAhXj
-    vExecCmdSSP2(ST7032_CMD_SET_ICON_ADDR);
-    __delay_us(ST7032_DEF_WAIT);
-    // CXgNVe[u`FWiIS=0j
-    vExecCmdEndSSP2(ST7032_CMD_FUNC_SET_DEF);
-    __delay_us(ST7032_DEF_WAIT);
-    // X^[gRfBV̑M
-    I2C_u8MstStartSSP2(ST7032_I2C_ADDR, false);
-    // Rg[oCgif[^j̑M
-    I2C_u8MstTxSSP2(ST7032_CNTR_DATA);
-    // f[^̑M
-    uint8 u8Addr;
-    for (u8Addr = 0x00; u8Addr < 0x10; u8Addr++) {
-        I2C_u8MstTxSSP2(0x00);
-        __delay_us(ST7032_DEF_WAIT);
+extern bool ST7032_bSetCursor(tsST7032_handle *psHandle, uint8 u8RowNo, uint8 u8ColNo) {
+    // 位置判定
+    if (u8RowNo > ST7032_ROW_MAX || u8ColNo > ST7032_COL_MAX) {
+        return false;
+    }
+    // カーソル移動判定
+    uint8 u8Addr = (u8RowNo * 40) + u8ColNo;
+    if (u8Addr == psHandle->u8CursorPos) {
+        return true;
     }
-    // Xgbvrbg;
-    I2C_vMstStopSSP2();
-    // X^[gRfBV̑M
-    I2C_u8MstStartSSP2(ST7032_I2C_ADDR, false);
-    // J[\ʒuĐݒ
-    bSetCursorSSP2(stStateSSP2.u8CursorPos);
+    // カーソル移動
+    return bSetCursor(psHandle, u8Addr);
 }
-#endif
 
 /*******************************************************************************
  *
- * NAME: ST7032_vDispIconSSP1
+ * NAME: ST7032_bCursorLeft
  *
- * DESCRIPTION:Icon Display Setting
+ * DESCRIPTION:Move cursor to left
  *
  * PARAMETERS:      Name            RW  Usage
- *        bool      bDisp           R   \ݒ
+ * tsST7032_handle* psHandle       RW  LCDハンドル
  *
  * RETURNS:
+ *     bool true:設定成功、false:設定失敗
  *
  * NOTES:
  * None.
  * 
  ******************************************************************************/
-extern void ST7032_vDispIconSSP1(bool bDisp) {
-    // XV
-    if ((stStateSSP1.u8Settings >> 7) == bDisp) {
-        return;
+extern bool ST7032_bCursorLeft(tsST7032_handle *psHandle) {
+    // カーソル位置判定
+    if (psHandle->u8CursorPos == 0) {
+        return false;
     }
-    // ACR\ݒ̍XV
-    stStateSSP1.u8Settings = (stStateSSP1.u8Settings & 0x7F) | (bDisp << 7);
-    // X^[gRfBV̑M
-    I2C_u8MstStartSSP1(ST7032_I2C_ADDR, false);
-    // t@NVݒ@IS(instruction table select)1
-    vExecCmdSSP1(ST7032_CMD_FUNC_SET_EX);
-    __delay_us(ST7032_DEF_WAIT);
-    // gfBXvCݒAACR\ONAu[X^[HONARgXgݒi2j
-    vExecCmdSSP1(ST7032_CMD_DISP_CNTR_EX | (stStateSSP1.u8Settings >> 4));
-    __delay_us(ST7032_DEF_WAIT);
-    // t@NVݒ@IS(instruction table select)0
-    vExecCmdSSP1(ST7032_CMD_FUNC_SET_DEF);
-    __delay_us(ST7032_DEF_WAIT);    
+    return bSetCursor(psHandle, psHandle->u8CursorPos - 1);
 }
 
 /*******************************************************************************
  *
- * NAME: ST7032_vDispIconSSP2
+ * NAME: ST7032_bCursorRight
  *
- * DESCRIPTION:Icon Display Setting
+ * DESCRIPTION:Move cursor to right
  *
  * PARAMETERS:      Name            RW  Usage
- *        bool      bDisp           R   \ݒ
+ * tsST7032_handle* psHandle       RW  LCDハンドル
  *
  * RETURNS:
+ *     bool true:設定成功、false:設定失敗
  *
  * NOTES:
  * None.
  * 
  ******************************************************************************/
-#ifdef SSP2STAT
-extern void ST7032_vDispIconSSP2(bool bDisp) {
-    // XV
-    if ((stStateSSP2.u8Settings >> 7) == bDisp) {
-        return;
+extern bool ST7032_bCursorRight(tsST7032_handle *psHandle) {
+    // カーソル位置判定
+    if (psHandle->u8CursorPos >= 79) {
+        return false;
     }
-    // ACR\ݒ̍XV
-    stStateSSP2.u8Settings = (stStateSSP2.u8Settings & 0x7F) | (bDisp << 7);
-    // X^[gRfBV̑M
-    I2C_u8MstStartSSP2(ST7032_I2C_ADDR, false);
-    // t@NVݒ@IS(instruction table select)1
-    vExecCmdSSP2(ST7032_CMD_FUNC_SET_EX);
-    __delay_us(ST7032_DEF_WAIT);
-    // gfBXvCݒAACR\ONAu[X^[HONARgXgݒi2j
-    vExecCmdSSP2(ST7032_CMD_DISP_CNTR_EX | (stStateSSP2.u8Settings >> 4));
-    __delay_us(ST7032_DEF_WAIT);
-    // t@NVݒ@IS(instruction table select)0
-    vExecCmdSSP2(ST7032_CMD_FUNC_SET_DEF);
-    __delay_us(ST7032_DEF_WAIT);
+    return bSetCursor(psHandle, psHandle->u8CursorPos + 1);
 }
-#endif
 
 /*******************************************************************************
  *
- * NAME: ST7032_vDispSettingSSP1
+ * NAME: ST7032_vWriteCGRAM
  *
- * DESCRIPTION:LCD Setting
+ * DESCRIPTION:Write CGRAM
  *
  * PARAMETERS:      Name            RW  Usage
- *        bool      bDisp           R   Display LCD
- *        bool      bCursor         R   Cursor Display
- *        bool      bBlink          R   Blink Cursor
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ *       uint8      u8CharNo        R   Character No
+ *       uint8*     pu8BitMap       R   Character Bit Map
  *
  * RETURNS:
  *
@@ -525,24 +580,38 @@ extern void ST7032_vDispIconSSP2(bool bDisp) {
  * None.
  * 
  ******************************************************************************/
-extern void ST7032_vDispSettingSSP1(bool bDisp, bool bCursor, bool bBlink) {
-    // X^[gRfBV̑M
-    I2C_u8MstStartSSP1(ST7032_I2C_ADDR, false);
-    // fBXvCݒA\ONAJ[\\OFFAJ[\_OFF
-    vExecCmdEndSSP1(ST7032_CMD_DISP_CNTR_DEF | (bDisp << 2) | (bCursor << 1) | bBlink);
-    __delay_us(ST7032_DEF_WAIT);
+extern void ST7032_vWriteCGRAM(tsST7032_handle *psHandle, uint8 u8CharNo, uint8* pu8BitMap) {
+    // スタートコンディションの送信
+    vStart(psHandle);
+    // CGRAMアドレス設定
+    vSetAddr(psHandle, ST7032_ADDR_CGRAM, (u8CharNo << 3) & 0x38);
+    // コントロールバイト（データ）の送信
+    I2C_u8MstTx(psHandle->psBus, ST7032_CNTR_DATA);
+    // CGRAMデータの送信
+    uint8 *pu8WkMap = pu8BitMap;
+    uint8 u8Idx;
+    for (u8Idx = 0; u8Idx < 8; u8Idx++) {
+        I2C_u8MstTx(psHandle->psBus, *pu8WkMap & 0x1F);
+        vPace(psHandle->u8PaceCnt);
+        pu8WkMap++;
+    }
+    // ストップコンディション
+    I2C_vMstStop(psHandle->psBus);
+    // アドレスカウンタの移動
+    psHandle->u8Addr = (psHandle->u8Addr + 8) & 0x3F;
+    // カーソル位置を戻す（カーソル表示中の場合のみ）
+    vRestoreCursor(psHandle);
 }
 
 /*******************************************************************************
  *
- * NAME: ST7032_vDispSettingSSP2
+ * NAME: ST7032_vWriteChar
  *
- * DESCRIPTION:LCD Setting
+ * DESCRIPTION:Write Character
  *
  * PARAMETERS:      Name            RW  Usage
- *        bool      bDisp           R   Display LCD
- *        bool      bCursor         R   Cursor Display
- *        bool      bBlink          R   Blink Cursor
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ *        char      cData           R   インストラクション
  *
  * RETURNS:
  *
@@ -550,353 +619,576 @@ extern void ST7032_vDispSettingSSP1(bool bDisp, bool bCursor, bool bBlink) {
  * None.
  * 
  ******************************************************************************/
-#ifdef SSP2STAT
-extern void ST7032_vDispSettingSSP2(bool bDisp, bool bCursor, bool bBlink) {
-    // X^[gRfBV̑M
-    I2C_u8MstStartSSP2(ST7032_I2C_ADDR, false);
-    // fBXvCݒA\ONAJ[\\OFFAJ[\_OFF
-    vExecCmdEndSSP2(ST7032_CMD_DISP_CNTR_DEF | (bDisp << 2) | (bCursor << 1) | bBlink);
-    __delay_us(ST7032_DEF_WAIT);
+extern void ST7032_vWriteChar(tsST7032_handle *psHandle, char cData) {
+    // スタートコンディションの送信
+    vStart(psHandle);
+    // アドレスカウンタをカーソル位置へ移動（一致している場合は省略）
+    vSetDDAddr(psHandle, psHandle->u8CursorPos);
+    // コントロールバイト（データ）の送信
+    I2C_u8MstTx(psHandle->psBus, ST7032_CNTR_DATA);
+    // データの送信
+    I2C_u8MstTx(psHandle->psBus, cData);
+    // ストップコンディション
+    I2C_vMstStop(psHandle->psBus);
+    // シャドウ表示データの同期とカーソル位置の移動
+    vSyncShadow(psHandle, (uint8*)&cData, 1);
 }
-#endif
 
 /*******************************************************************************
  *
- * NAME: ST7032_u8GetCursorRowNoSSP1
+ * NAME: ST7032_vWriteString
  *
- * DESCRIPTION:get cursor row no
+ * DESCRIPTION:Write String
  *
  * PARAMETERS:      Name            RW  Usage
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ *       char*      pcStr           R   文字列のポインタ
  *
  * RETURNS:
- *    uint8 J[\s
  *
  * NOTES:
  * None.
  * 
  ******************************************************************************/
-extern uint8 ST7032_u8GetCursorRowNoSSP1() {
-    return stStateSSP1.u8CursorPos / 40;
+extern void ST7032_vWriteString(tsST7032_handle *psHandle, char* pcStr) {
+    // スタートコンディションの送信
+    vStart(psHandle);
+    // アドレスカウンタをカーソル位置へ移動（一致している場合は省略）
+    vSetDDAddr(psHandle, psHandle->u8CursorPos);
+    // コントロールバイト（データ）の送信
+    I2C_u8MstTx(psHandle->psBus, ST7032_CNTR_DATA);
+    // データの送信
+    char* pcWkData = pcStr;
+    while (*pcWkData != '\0') {
+        I2C_u8MstTx(psHandle->psBus, *pcWkData);
+        vPace(psHandle->u8PaceCnt);
+        pcWkData++;
+    }
+    // ストップコンディション
+    I2C_vMstStop(psHandle->psBus);
+    // シャドウ表示データの同期とカーソル位置の移動
+    vSyncShadow(psHandle, (uint8*)pcStr, (uint8)(pcWkData - pcStr));
 }
 
 /*******************************************************************************
  *
- * NAME: ST7032_u8GetCursorRowNoSSP2
+ * NAME: ST7032_vWriteData
  *
- * DESCRIPTION:get cursor row no
+ * DESCRIPTION:Write Data
  *
  * PARAMETERS:      Name            RW  Usage
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ *      uint8*      pcData          R   データのポインタ
+ *      uint8       u8Len           R   配列サイズ 
  *
  * RETURNS:
- *    uint8 J[\s
  *
  * NOTES:
  * None.
  * 
  ******************************************************************************/
-#ifdef SSP2STAT
-extern uint8 ST7032_u8GetCursorRowNoSSP2() {
-    return stStateSSP2.u8CursorPos / 40;
+extern void ST7032_vWriteData(tsST7032_handle *psHandle, uint8* pcData, uint8 u8Len) {
+    // スタートコンディションの送信
+    vStart(psHandle);
+    // アドレスカウンタをカーソル位置へ移動（一致している場合は省略）
+    vSetDDAddr(psHandle, psHandle->u8CursorPos);
+    // コントロールバイト（データ）の送信
+    I2C_u8MstTx(psHandle->psBus, ST7032_CNTR_DATA);
+    // データの送信
+    uint8* pu8WkData = pcData;
+    uint8 u8Idx;
+    for (u8Idx = 0; u8Idx < u8Len; u8Idx++) {
+        I2C_u8MstTx(psHandle->psBus, *pu8WkData);
+        vPace(psHandle->u8PaceCnt);
+        pu8WkData++;
+    }
+    // ストップコンディション
+    I2C_vMstStop(psHandle->psBus);
+    // シャドウ表示データの同期とカーソル位置の移動
+    vSyncShadow(psHandle, pcData, u8Len);
 }
-#endif
 
 /*******************************************************************************
  *
- * NAME: ST7032_u8GetCursorColNoSSP1
+ * NAME: ST7032_vWriteIcon
  *
- * DESCRIPTION:get cursor column no
+ * DESCRIPTION:アイコンの書き込み
  *
  * PARAMETERS:      Name            RW  Usage
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ *       uint8      u8Addr          R   ICON Address
+ *       uint8      u8Map           R   ICON Bit Map
  *
  * RETURNS:
- *    uint8 J[\AhX
  *
  * NOTES:
  * None.
  * 
  ******************************************************************************/
-extern uint8 ST7032_u8GetCursorColNoSSP1() {
-    return stStateSSP1.u8CursorPos % 40;
+extern void ST7032_vWriteIcon(tsST7032_handle *psHandle, uint8 u8Addr, uint8 u8Map) {
+    // スタートコンディションの送信
+    vStart(psHandle);
+    // アイコンアドレス設定
+    vSetAddr(psHandle, ST7032_ADDR_ICON, u8Addr & 0x0F);
+    psHandle->u8Addr++;
+    // カーソル位置の復帰要否
+    bool bRestore = bNeedRestore(psHandle);
+    // コントロールバイト（データ）とデータの送信
+    if (bRestore) {
+        I2C_u8MstTx(psHandle->psBus, ST7032_CNTR_DATA | ST7032_CNTR_CO);
+    } else {
+        I2C_u8MstTx(psHandle->psBus, ST7032_CNTR_DATA);
+    }
+    I2C_u8MstTx(psHandle->psBus, u8Map & 0x1F);
+    if (bRestore) {
+        vPace(psHandle->u8PaceCnt);
+        // カーソル位置を戻す（同一トランザクション）
+        psHandle->u8AddrMode = ST7032_ADDR_DDRAM;
+        psHandle->u8Addr     = psHandle->u8CursorPos;
+        vExecCmdEnd(psHandle, u8SetDDAddrCmd(psHandle->u8CursorPos));
+    } else {
+        // ストップコンディション
+        I2C_vMstStop(psHandle->psBus);
+        vSetBusy(psHandle, ST7032_EXEC_TICKS);
+    }
 }
 
 /*******************************************************************************
  *
- * NAME: ST7032_u8GetCursorColNoSSP2
+ * NAME: ST7032_vWriteIcons
  *
- * DESCRIPTION:get cursor column no
+ * DESCRIPTION:アイコンの一括書き込み
  *
  * PARAMETERS:      Name            RW  Usage
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ *      uint8*      pu8Map          R   ICON Bit Map（アドレス0x00-0x0F）
+ *      uint16      u16Mask         R   書き込み対象（ビット位置＝ICON Address）
  *
  * RETURNS:
- *    uint8 J[\ԍ
  *
  * NOTES:
- * None.
+ * １回のトランザクションで対象アイコンの書き込みとカーソル位置の復帰
+ * （カーソル表示中の場合のみ）を行う。
+ * IS=1への切り替えは必要な場合のみ行い、IS=0へは戻さない。
+ * 連続するアドレスはアドレスカウンタの自動インクリメントを利用する。
  * 
  ******************************************************************************/
-#ifdef SSP2STAT
-extern uint8 ST7032_u8GetCursorColNoSSP2() {
-    return stStateSSP2.u8CursorPos % 40;
+extern void ST7032_vWriteIcons(tsST7032_handle *psHandle, uint8* pu8Map, uint16 u16Mask) {
+    // 入力チェック
+    if (u16Mask == 0x0000) {
+        return;
+    }
+    // カーソル位置の復帰要否（アイコン書き込み後は必ずDDRAM外を指す）
+    bool bRestore = ((psHandle->u8DispCntr & 0x03) != 0x00);
+    // スタートコンディションの送信
+    vStart(psHandle);
+    // 対象アイコンの書き込み
+    uint8 u8Addr;
+    for (u8Addr = 0x00; u8Addr < 0x10; u8Addr++) {
+        if ((u16Mask & 0x0001) != 0x0000) {
+            // アイコンアドレス設定（連続する場合は省略される）
+            vSetAddr(psHandle, ST7032_ADDR_ICON, u8Addr);
+            // コントロールバイト（データ）の送信、最後のデータ以外は継続
+            if (bRestore || (u16Mask >> 1) != 0x0000) {
+                I2C_u8MstTx(psHandle->psBus, ST7032_CNTR_DATA | ST7032_CNTR_CO);
+            } else {
+                I2C_u8MstTx(psHandle->psBus, ST7032_CNTR_DATA);
+            }
+            // データの送信
+            I2C_u8MstTx(psHandle->psBus, pu8Map[u8Addr] & 0x1F);
+            vPace(psHandle->u8PaceCnt);
+            psHandle->u8Addr++;
+        }
+        u16Mask = u16Mask >> 1;
+    }
+    if (bRestore) {
+        // カーソル位置を戻す
+        psHandle->u8AddrMode = ST7032_ADDR_DDRAM;
+        psHandle->u8Addr     = psHandle->u8CursorPos;
+        vExecCmdEnd(psHandle, u8SetDDAddrCmd(psHandle->u8CursorPos));
+    } else {
+        // ストップコンディション
+        I2C_vMstStop(psHandle->psBus);
+        vSetBusy(psHandle, ST7032_EXEC_TICKS);
+    }
 }
-#endif
-
 
 /*******************************************************************************
  *
- * NAME: ST7032_bSetCursorSSP1
+ * NAME: ST7032_vExecList
  *
- * DESCRIPTION:Move cursor
+ * DESCRIPTION:Execute Command List
  *
  * PARAMETERS:      Name            RW  Usage
- *       uint8      u8RowNo         R   Row No
- *       uint8      u8ColNo         R   Column No
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ * const uint8*     pu8List         R   コマンドリスト（コントロールバイトと値の組）
+ *       uint8      u8Cnt           R   組の数
  *
  * RETURNS:
- *     bool true:ݒ萬Afalse:ݒ莸s
  *
  * NOTES:
- * None.
+ * コントロールバイトはST7032_LIST_CMD又はST7032_LIST_DATAを指定する。
+ * １回のトランザクションで送信し、最後の組のみ継続ビット（Co）をクリアする。
+ * クリアディスプレイとリターンホームはリストの最後にのみ指定できる。
+ * 実行後は記憶しているコントローラの状態（IS、アドレス等）を破棄する。
  * 
  ******************************************************************************/
-extern bool ST7032_bSetCursorSSP1(uint8 u8RowNo, uint8 u8ColNo) {
-    // ʒu
-    if (u8RowNo > ST7032_ROW_MAX || u8ColNo > ST7032_COL_MAX) {
-        return false;
+extern void ST7032_vExecList(tsST7032_handle *psHandle, const uint8* pu8List, uint8 u8Cnt) {
+    // 入力チェック
+    if (u8Cnt == 0) {
+        return;
     }
-    // J[\ړ
-    uint8 u8Addr = (u8RowNo * 40) + u8ColNo;
-    if (u8Addr == stStateSSP1.u8CursorPos) {
-        return true;
+    // スタートコンディションの送信
+    vStart(psHandle);
+    // 最後の組以外を送信
+    vSendList(psHandle, pu8List, u8Cnt - 1);
+    pu8List = pu8List + (u8Cnt - 1) * 2;
+    // 最後の組を送信
+    I2C_u8MstTx(psHandle->psBus, pu8List[0] & ~ST7032_CNTR_CO);
+    I2C_u8MstTx(psHandle->psBus, pu8List[1]);
+    // ストップコンディション
+    I2C_vMstStop(psHandle->psBus);
+    // コントローラの状態は不明とする
+    vResetCache(psHandle);
+    // 命令実行の完了予定時刻
+    if ((pu8List[0] & ST7032_CNTR_DATA) == 0 && pu8List[1] < (ST7032_CMD_RETURN_HOME << 1)) {
+        vSetBusy(psHandle, ST7032_EX_TICKS);
+    } else {
+        vSetBusy(psHandle, ST7032_EXEC_TICKS);
     }
-    // J[\ړ
-    return bSetCursorSSP1(u8Addr);
 }
 
 /*******************************************************************************
  *
- * NAME: ST7032_bSetCursorSSP2
+ * NAME: ST7032_bSetShadow
  *
- * DESCRIPTION:Move cursor
+ * DESCRIPTION:Set Shadow Display Data
  *
  * PARAMETERS:      Name            RW  Usage
+ * tsST7032_handle* psHandle       RW  LCDハンドル
  *       uint8      u8RowNo         R   Row No
  *       uint8      u8ColNo         R   Column No
+ *      uint8*      pu8Data         R   データのポインタ
+ *      uint8       u8Len           R   配列サイズ
  *
  * RETURNS:
- *     bool true:ݒ萬Afalse:ݒ莸s
+ *     bool true:設定成功、false:設定失敗
  *
  * NOTES:
- * None.
+ * LCDへの送信は行わず、変更されたセルを更新セルとして記録する。
+ * シャドウの桁数を超える部分は切り捨てる。
+ * 非同期送信中の場合は、送信中のシャドウを書き換えない様に完了を待つ。
+ * 
+ ******************************************************************************/
+extern bool ST7032_bSetShadow(tsST7032_handle *psHandle, uint8 u8RowNo, uint8 u8ColNo,
+                                   uint8* pu8Data, uint8 u8Len) {
+    vWaitFlush(psHandle);
+    return bSetShadow(psHandle, u8RowNo, u8ColNo, pu8Data, u8Len);
+}
+
+/*******************************************************************************
+ *
+ * NAME: ST7032_vFlush
+ *
+ * DESCRIPTION:Flush Shadow Display Data
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 更新セルの連続区間（ラン）毎にDDRAMアドレスを１回だけ設定して送信する。
+ * 送信後はカーソル位置を元に戻す。
+ * SSP2に接続され、1バイト毎の待ちが不要な場合は非同期トランザクションで
+ * 送信を開始して復帰し、以降のランとカーソル位置の復帰は完了通知の割り込みで
+ * 順次送信する。完了はST7032_bFlushBusyで判定でき、他の操作は完了を待ってから
+ * 実行される。
  * 
  ******************************************************************************/
+extern void ST7032_vFlush(tsST7032_handle *psHandle) {
+    uint8 u8Idx = 0;
+    uint8 u8Len;
+    bool bFlushed = false;
+    // 前回の非同期送信の完了待ち
+    vWaitFlush(psHandle);
 #ifdef SSP2STAT
-extern bool ST7032_bSetCursorSSP2(uint8 u8RowNo, uint8 u8ColNo) {
-    // ʒu
-    if (u8RowNo > ST7032_ROW_MAX || u8ColNo > ST7032_COL_MAX) {
-        return false;
+    // 非同期送信
+    if (psHandle->psBus == I2C_BUS_SSP2 && psHandle->u8PaceCnt == 0) {
+        // 直前の命令の完了待ち（エラー発生時は全セルが更新セルとなる）
+        vWaitReady(psHandle);
+        u8Len = u8SearchRun(psHandle, &u8Idx);
+        if (u8Len == 0) {
+            return;
+        }
+        // 最初のランを登録（以降は完了通知で登録）
+        psHandle->bFlushing = true;
+        vSubmitRun(psHandle, u8Idx, u8Len);
+        return;
     }
-    // J[\ړ
-    uint8 u8Addr = (u8RowNo * 40) + u8ColNo;
-    if (u8Addr == stStateSSP2.u8CursorPos) {
-        return true;
+#endif
+    // 更新ラン毎に送信
+    while ((u8Len = u8SearchRun(psHandle, &u8Idx)) > 0) {
+        vWriteRun(psHandle, u8Idx, u8Len);
+        u8Idx = u8Idx + u8Len;
+        bFlushed = true;
+    }
+    // カーソル位置を戻す（カーソル表示中の場合のみ）
+    if (bFlushed) {
+        vRestoreCursor(psHandle);
     }
-    // J[\ړ
-    return bSetCursorSSP2(u8Addr);
 }
-#endif
+
 
 /*******************************************************************************
  *
- * NAME: ST7032_bCursorLeftSSP1
+ * NAME: ST7032_bFlushBusy
  *
- * DESCRIPTION:Move cursor to left
+ * DESCRIPTION:Check flush busy
  *
  * PARAMETERS:      Name            RW  Usage
+ * tsST7032_handle* psHandle        R   LCDハンドル
  *
  * RETURNS:
- *     bool true:ݒ萬Afalse:ݒ莸s
+ *     bool true:シャドウ表示データの非同期送信中
  *
  * NOTES:
  * None.
  * 
  ******************************************************************************/
-extern bool ST7032_bCursorLeftSSP1() {
-    // J[\ʒu
-    if (stStateSSP1.u8CursorPos == 0) {
-        return false;
+extern bool ST7032_bFlushBusy(tsST7032_handle *psHandle) {
+    return psHandle->bFlushing;
+}
+
+/*******************************************************************************
+ *
+ * NAME: ST7032_vInvalidate
+ *
+ * DESCRIPTION:Invalidate cached state
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * LCDの電源断やリセット等でコントローラの状態が不明となった場合に呼び出す。
+ * 記憶しているファンクション設定、ディスプレイ設定、アドレスカウンタを破棄し、
+ * シャドウ表示データを全て更新セルとする。非同期送信中の場合は完了を待つ。
+ * 
+ ******************************************************************************/
+extern void ST7032_vInvalidate(tsST7032_handle *psHandle) {
+    vWaitFlush(psHandle);
+    vInvalidate(psHandle);
+}
+
+/******************************************************************************/
+/***        Local Functions                                                 ***/
+/******************************************************************************/
+
+/*******************************************************************************
+ *
+ * NAME: vStart
+ *
+ * DESCRIPTION:Wait ready and send start condition
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 直前の命令の実行中であれば、完了予定時刻まで待ってから送信を開始する。
+ * 
+ ******************************************************************************/
+static void vStart(tsST7032_handle *psHandle) {
+    // 非同期送信と直前の命令の完了待ち
+    vWaitFlush(psHandle);
+    vWaitReady(psHandle);
+    // スタートコンディションの送信
+    I2C_u8MstStart(psHandle->psBus, psHandle->u8Address, false);
+}
+
+/*******************************************************************************
+ *
+ * NAME: vWaitReady
+ *
+ * DESCRIPTION:Wait ready
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 直前のトランザクションでNACK受信又はタイムアウト（バス復旧）が発生した場合は、
+ * 記憶しているコントローラの状態を破棄し、シャドウ表示データを全て更新セルとする。
+ * 
+ ******************************************************************************/
+static void vWaitReady(tsST7032_handle *psHandle) {
+    // 直前のトランザクションのエラー判定
+    if (I2C_bMstError(psHandle->psBus)) {
+        vInvalidate(psHandle);
     }
-    return bSetCursorSSP1(stStateSSP1.u8CursorPos - 1);
+    // 残り時間が最大実行時間以内なら実行中（超える場合は完了予定時刻を経過済み）
+    while ((uint16)(psHandle->u16BusyEnd - timer1_u16GetTick() - 1) < ST7032_EX_TICKS);
 }
 
 /*******************************************************************************
  *
- * NAME: ST7032_bCursorLeftSSP2
+ * NAME: vSendList
  *
- * DESCRIPTION:Move cursor to left
+ * DESCRIPTION:Send command list (Co=1)
  *
  * PARAMETERS:      Name            RW  Usage
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ * const uint8*     pu8List         R   コマンドリスト（コントロールバイトと値の組）
+ *       uint8      u8Cnt           R   組の数
  *
  * RETURNS:
- *     bool true:ݒ萬Afalse:ݒ莸s
  *
  * NOTES:
- * None.
+ * 継続ビット（Co）を付けて送信する。スタート／ストップコンディションは送信しない。
  * 
  ******************************************************************************/
-#ifdef SSP2STAT
-extern bool ST7032_bCursorLeftSSP2() {
-    // J[\ʒu
-    if (stStateSSP2.u8CursorPos == 0) {
-        return false;
+static void vSendList(tsST7032_handle *psHandle, const uint8* pu8List, uint8 u8Cnt) {
+    for (; u8Cnt > 0; u8Cnt--) {
+        // コントロールバイトの送信
+        I2C_u8MstTx(psHandle->psBus, *pu8List | ST7032_CNTR_CO);
+        pu8List++;
+        // コマンド又はデータの送信
+        I2C_u8MstTx(psHandle->psBus, *pu8List);
+        pu8List++;
+        vPace(psHandle->u8PaceCnt);
     }
-    return bSetCursorSSP2(stStateSSP2.u8CursorPos - 1);
 }
-#endif
 
 /*******************************************************************************
  *
- * NAME: ST7032_bCursorRightSSP1
+ * NAME: vSetDDAddr
  *
- * DESCRIPTION:Move cursor to right
+ * DESCRIPTION:Set DDRAM address
  *
  * PARAMETERS:      Name            RW  Usage
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ *       uint8      u8Pos           R   Cursor Position
  *
  * RETURNS:
- *     bool true:ݒ萬Afalse:ݒ莸s
  *
  * NOTES:
- * None.
+ * トランザクション中に呼び出す。アドレスカウンタが既に指定位置を指している
+ * 場合は送信しない。
  * 
  ******************************************************************************/
-extern bool ST7032_bCursorRightSSP1() {
-    // J[\ʒu
-    if (stStateSSP1.u8CursorPos >= 79) {
-        return false;
+static void vSetDDAddr(tsST7032_handle *psHandle, uint8 u8Pos) {
+    if (psHandle->u8AddrMode == ST7032_ADDR_DDRAM && psHandle->u8Addr == u8Pos) {
+        return;
     }
-    return bSetCursorSSP1(stStateSSP1.u8CursorPos + 1);
+    vExecCmd(psHandle, u8SetDDAddrCmd(u8Pos));
+    vPace(psHandle->u8PaceCnt);
+    psHandle->u8AddrMode = ST7032_ADDR_DDRAM;
+    psHandle->u8Addr     = u8Pos;
 }
 
 /*******************************************************************************
  *
- * NAME: ST7032_bCursorRightSSP2
+ * NAME: vRestoreCursor
  *
- * DESCRIPTION:Move cursor to right
+ * DESCRIPTION:Restore cursor
  *
  * PARAMETERS:      Name            RW  Usage
+ * tsST7032_handle* psHandle       RW  LCDハンドル
  *
  * RETURNS:
- *     bool true:ݒ萬Afalse:ݒ莸s
  *
  * NOTES:
- * None.
+ * カーソル又はブリンクを表示中で、アドレスカウンタがカーソル位置と異なる場合
+ * のみ送信する。
  * 
  ******************************************************************************/
-#ifdef SSP2STAT
-extern bool ST7032_bCursorRightSSP2() {
-    // J[\ʒu
-    if (stStateSSP2.u8CursorPos >= 79) {
-        return false;
+static void vRestoreCursor(tsST7032_handle *psHandle) {
+    vWaitFlush(psHandle);
+    if (!bNeedRestore(psHandle)) {
+        return;
     }
-    return bSetCursorSSP2(stStateSSP2.u8CursorPos + 1);
+    // スタートコンディションの送信
+    vStart(psHandle);
+    // カーソル設定
+    psHandle->u8AddrMode = ST7032_ADDR_DDRAM;
+    psHandle->u8Addr     = psHandle->u8CursorPos;
+    vExecCmdEnd(psHandle, u8SetDDAddrCmd(psHandle->u8CursorPos));
 }
-#endif
 
 /*******************************************************************************
  *
- * NAME: ST7032_vWriteCGRAMSSP1
+ * NAME: vSelectTable
  *
- * DESCRIPTION:Write CGRAM
+ * DESCRIPTION:Select instruction table
  *
  * PARAMETERS:      Name            RW  Usage
- *       uint8      u8CharNo        R   Character No
- *       uint8*     pu8BitMap       R   Character Bit Map
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ *       uint8      u8FuncSet       R   ファンクション設定（IS=0又はIS=1）
  *
  * RETURNS:
  *
  * NOTES:
- * None.
+ * トランザクション中に呼び出す。現在のテーブルと同じ場合は送信しない。
  * 
  ******************************************************************************/
-extern void ST7032_vWriteCGRAMSSP1(uint8 u8CharNo, uint8* pu8BitMap) {
-    // X^[gRfBV̑M
-    I2C_u8MstStartSSP1(ST7032_I2C_ADDR, false);
-    // t@NVݒ@IS(instruction table select)0
-    vExecCmdSSP1(ST7032_CMD_FUNC_SET_DEF);
-    __delay_us(ST7032_DEF_WAIT);
-    // CGRAMAhXݒ
-    vExecCmdSSP1(ST7032_CMD_SET_CGRAM | ((u8CharNo << 3) & 0x38));
-    __delay_us(ST7032_DEF_WAIT);
-    // Rg[oCgif[^j̑M
-    I2C_u8MstTxSSP1(ST7032_CNTR_DATA);
-    // CGRAMf[^̑M
-    uint8 *pu8WkMap = pu8BitMap;
-    uint8 u8Idx;
-    for (u8Idx = 0; u8Idx < 8; u8Idx++) {
-        I2C_u8MstTxSSP1(*pu8WkMap & 0x1F);
-        __delay_us(ST7032_DEF_WAIT);
-        pu8WkMap++;
+static void vSelectTable(tsST7032_handle *psHandle, uint8 u8FuncSet) {
+    if (psHandle->u8FuncSet == u8FuncSet) {
+        return;
     }
-    // XgbvRfBV
-    I2C_vMstStopSSP1();
-    // X^[gRfBV̑M
-    I2C_u8MstStartSSP1(ST7032_I2C_ADDR, false);
-    // J[\Đݒ
-    bSetCursorSSP1(stStateSSP1.u8CursorPos);
+    psHandle->u8FuncSet = u8FuncSet;
+    vExecCmd(psHandle, u8FuncSet);
+    vPace(psHandle->u8PaceCnt);
 }
 
 /*******************************************************************************
  *
- * NAME: ST7032_vWriteCGRAMSSP2
+ * NAME: vSetAddr
  *
- * DESCRIPTION:Write CGRAM
+ * DESCRIPTION:Set CGRAM/ICON RAM address
  *
  * PARAMETERS:      Name            RW  Usage
- *       uint8      u8CharNo        R   Character No
- *       uint8*     pu8BitMap       R   Character Bit Map
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ *       uint8      u8Mode          R   ST7032_ADDR_CGRAM又はST7032_ADDR_ICON
+ *       uint8      u8Addr          R   アドレス
  *
  * RETURNS:
  *
  * NOTES:
- * None.
+ * トランザクション中に呼び出す。アドレスカウンタが既に指定アドレスを指している
+ * 場合は送信しない。インストラクションテーブルは必要な場合のみ切り替える。
  * 
  ******************************************************************************/
-#ifdef SSP2STAT
-extern void ST7032_vWriteCGRAMSSP2(uint8 u8CharNo, uint8* pu8BitMap) {
-    // X^[gRfBV̑M
-    I2C_u8MstStartSSP2(ST7032_I2C_ADDR, false);
-    // t@NVݒ@IS(instruction table select)0
-    vExecCmdSSP2(ST7032_CMD_FUNC_SET_DEF);
-    __delay_us(ST7032_DEF_WAIT);
-    // CGRAMAhXݒ
-    vExecCmdSSP2(ST7032_CMD_SET_CGRAM | ((u8CharNo << 3) & 0x38));
-    __delay_us(ST7032_DEF_WAIT);
-    // Rg[oCgif[^j̑M
-    I2C_u8MstTxSSP2(ST7032_CNTR_DATA);
-    // CGRAMf[^̑M
-    uint8 *pu8WkMap = pu8BitMap;
-    uint8 u8Idx;
-    for (u8Idx = 0; u8Idx < 8; u8Idx++) {
-        I2C_u8MstTxSSP2(*pu8WkMap & 0x1F);
-        __delay_us(ST7032_DEF_WAIT);
-        pu8WkMap++;
+static void vSetAddr(tsST7032_handle *psHandle, uint8 u8Mode, uint8 u8Addr) {
+    if (psHandle->u8AddrMode == u8Mode && psHandle->u8Addr == u8Addr) {
+        return;
+    }
+    if (u8Mode == ST7032_ADDR_CGRAM) {
+        // CGRAMアドレス設定はIS=0
+        vSelectTable(psHandle, ST7032_CMD_FUNC_SET_DEF);
+        vExecCmd(psHandle, ST7032_CMD_SET_CGRAM | u8Addr);
+    } else {
+        // アイコンアドレス設定はIS=1
+        vSelectTable(psHandle, ST7032_CMD_FUNC_SET_EX);
+        vExecCmd(psHandle, ST7032_CMD_SET_ICON_ADDR | u8Addr);
     }
-    // XgbvRfBV
-    I2C_vMstStopSSP2();
-    // X^[gRfBV̑M
-    I2C_u8MstStartSSP2(ST7032_I2C_ADDR, false);
-    // J[\Đݒ
-    bSetCursorSSP2(stStateSSP2.u8CursorPos);
+    vPace(psHandle->u8PaceCnt);
+    psHandle->u8AddrMode = u8Mode;
+    psHandle->u8Addr     = u8Addr;
 }
-#endif
 
 /*******************************************************************************
  *
- * NAME: ST7032_vWriteCharSSP1
+ * NAME: vExecCmd
  *
- * DESCRIPTION:Write Character
+ * DESCRIPTION:LCDインストラクションの実行
  *
  * PARAMETERS:      Name            RW  Usage
- *        char      cData           R   CXgNV
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ *       uint8      u8Cmd           R   インストラクション      
  *
  * RETURNS:
  *
@@ -904,27 +1196,22 @@ extern void ST7032_vWriteCGRAMSSP2(uint8 u8CharNo, uint8* pu8BitMap) {
  * None.
  * 
  ******************************************************************************/
-extern void ST7032_vWriteCharSSP1(char cData) {
-    // X^[gRfBV̑M
-    I2C_u8MstStartSSP1(ST7032_I2C_ADDR, false);
-    // Rg[oCgif[^j̑M
-    I2C_u8MstTxSSP1(ST7032_CNTR_DATA);
-    // f[^̑M
-    I2C_u8MstTxSSP1(cData);
-    // XgbvRfBV
-    I2C_vMstStopSSP1();
-    // J[\ʒüړ
-    stStateSSP1.u8CursorPos = (stStateSSP1.u8CursorPos + 1) % 80;
+static void vExecCmd(tsST7032_handle *psHandle, uint8 u8Cmd) {
+    // コントロールバイト（コマンド）の送信
+    I2C_u8MstTx(psHandle->psBus, ST7032_CNTR_CMD | ST7032_CNTR_CO);
+    // コマンドの送信
+    I2C_u8MstTx(psHandle->psBus, u8Cmd);
 }
 
 /*******************************************************************************
  *
- * NAME: ST7032_vWriteCharSSP2
+ * NAME: vExecCmdEnd
  *
- * DESCRIPTION:Write Character
+ * DESCRIPTION:Execute Command and Stop End
  *
  * PARAMETERS:      Name            RW  Usage
- *        char      cData           R   CXgNV
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ *       uint8      u8Cmd           R   インストラクション      
  *
  * RETURNS:
  *
@@ -932,63 +1219,53 @@ extern void ST7032_vWriteCharSSP1(char cData) {
  * None.
  * 
  ******************************************************************************/
-#ifdef SSP2STAT
-extern void ST7032_vWriteCharSSP2(char cData) {
-    // X^[gRfBV̑M
-    I2C_u8MstStartSSP2(ST7032_I2C_ADDR, false);
-    // Rg[oCgif[^j̑M
-    I2C_u8MstTxSSP2(ST7032_CNTR_DATA);
-    // f[^̑M
-    I2C_u8MstTxSSP2(cData);
-    // XgbvRfBV
-    I2C_vMstStopSSP2();
-    // J[\ʒüړ
-    stStateSSP2.u8CursorPos = (stStateSSP2.u8CursorPos + 1) % 80;
+static void vExecCmdEnd(tsST7032_handle *psHandle, uint8 u8Cmd) {
+    // コントロールバイト（コマンド）の送信
+    I2C_u8MstTx(psHandle->psBus, ST7032_CNTR_CMD);
+    // コマンドの送信
+    I2C_u8MstTx(psHandle->psBus, u8Cmd);
+    // ストップコンディション
+    I2C_vMstStop(psHandle->psBus);
+    // 命令実行の完了予定時刻
+    vSetBusy(psHandle, ST7032_EXEC_TICKS);
 }
-#endif
 
 /*******************************************************************************
  *
- * NAME: ST7032_vWriteStringSSP1
+ * NAME: bSetCursor
  *
- * DESCRIPTION:Write String
+ * DESCRIPTION:Move cursor
  *
  * PARAMETERS:      Name            RW  Usage
- *       char*      pcStr           R   ̃|C^
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ *       uint8      u8Pos           R   Cursor Position
  *
  * RETURNS:
+ *     bool true:設定成功、false:設定失敗
  *
  * NOTES:
  * None.
  * 
  ******************************************************************************/
-extern void ST7032_vWriteStringSSP1(char* pcStr) {
-    // X^[gRfBV̑M
-    I2C_u8MstStartSSP1(ST7032_I2C_ADDR, false);
-    // Rg[oCgif[^j̑M
-    I2C_u8MstTxSSP1(ST7032_CNTR_DATA);
-    // f[^̑M
-    char* pcWkData = pcStr;
-    while (*pcWkData != '\0') {
-        I2C_u8MstTxSSP1(*pcWkData);
-        __delay_us(ST7032_DEF_WAIT);
-        pcWkData++;
-    }
-    // XgbvRfBV
-    I2C_vMstStopSSP1();
-    // J[\ʒüړ
-    stStateSSP1.u8CursorPos =
-            (stStateSSP1.u8CursorPos + (pcWkData - pcStr)) % 80;
+static bool bSetCursor(tsST7032_handle *psHandle, uint8 u8Pos) {
+    // カーソル位置の更新
+    psHandle->u8CursorPos = u8Pos;
+    // カーソル表示中の場合のみ即時に移動（非表示の場合は次の書き込み時に移動）
+    vRestoreCursor(psHandle);
+    // 設定成功
+    return true;
 }
 
 /*******************************************************************************
  *
- * NAME: ST7032_vWriteStringSSP2
+ * NAME: vWriteRun
  *
- * DESCRIPTION:Write String
+ * DESCRIPTION:Write shadow run
  *
  * PARAMETERS:      Name            RW  Usage
- *        char      pcStr           R   ̃|C^
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ *       uint8      u8Idx           R   シャドウ表示データの先頭インデックス
+ *       uint8      u8Len           R   ランの長さ
  *
  * RETURNS:
  *
@@ -996,110 +1273,129 @@ extern void ST7032_vWriteStringSSP1(char* pcStr) {
  * None.
  * 
  ******************************************************************************/
-#ifdef SSP2STAT
-extern void ST7032_vWriteStringSSP2(char* pcStr) {
-    // X^[gRfBV̑M
-    I2C_u8MstStartSSP2(ST7032_I2C_ADDR, false);
-    // Rg[oCgif[^j̑M
-    I2C_u8MstTxSSP2(ST7032_CNTR_DATA);
-    // f[^̑M
-    char* pcWkData = pcStr;
-    while (*pcWkData != '\0') {
-        I2C_u8MstTxSSP2(*pcWkData);
-        __delay_us(ST7032_DEF_WAIT);
-        pcWkData++;
+static void vWriteRun(tsST7032_handle *psHandle, uint8 u8Idx, uint8 u8Len) {
+    // カーソル位置（通し番号）へ変換
+    uint8 u8Pos = (u8Idx / ST7032_SHADOW_COL_SIZE) * 40
+                    + (u8Idx % ST7032_SHADOW_COL_SIZE);
+    // スタートコンディションの送信
+    vStart(psHandle);
+    // カーソル設定（アドレスカウンタが一致している場合は省略）
+    vSetDDAddr(psHandle, u8Pos);
+    // コントロールバイト（データ）の送信
+    I2C_u8MstTx(psHandle->psBus, ST7032_CNTR_DATA);
+    // データの送信
+    uint8 u8EndIdx = u8Idx + u8Len;
+    for (; u8Idx < u8EndIdx; u8Idx++) {
+        I2C_u8MstTx(psHandle->psBus, psHandle->u8Shadow[u8Idx]);
+        vPace(psHandle->u8PaceCnt);
     }
-    // XgbvRfBV
-    I2C_vMstStopSSP2();    
-    // J[\ʒüړ
-    stStateSSP2.u8CursorPos =
-            (stStateSSP2.u8CursorPos + (pcWkData - pcStr)) % 80;
+    // 更新セルのクリア
+    vSetDirty(psHandle, u8EndIdx - u8Len, u8Len, false);
+    // ストップコンディション
+    I2C_vMstStop(psHandle->psBus);
+    // アドレスカウンタの移動
+    psHandle->u8Addr = (psHandle->u8Addr + u8Len) % 80;
 }
-#endif
 
 /*******************************************************************************
  *
- * NAME: ST7032_vWriteDataSSP1
+ * NAME: u8SetDDAddrCmd
  *
- * DESCRIPTION:Write Data
+ * DESCRIPTION:Convert cursor position to DDRAM address command
  *
  * PARAMETERS:      Name            RW  Usage
- *      uint8*      pcData          R   f[^̃|C^
- *      uint8       u8Len           R   zTCY 
+ *       uint8      u8Pos           R   Cursor Position
  *
  * RETURNS:
+ *     uint8 カーソルアドレス設定コマンド
  *
  * NOTES:
  * None.
  * 
  ******************************************************************************/
-extern void ST7032_vWriteDataSSP1(uint8* pcData, uint8 u8Len) {
-    // X^[gRfBV̑M
-    I2C_u8MstStartSSP1(ST7032_I2C_ADDR, false);
-    // Rg[oCgif[^j̑M
-    I2C_u8MstTxSSP1(ST7032_CNTR_DATA);
-    // f[^̑M
-    uint8* pu8WkData = pcData;
-    uint8 u8Idx;
-    for (u8Idx = 0; u8Idx < u8Len; u8Idx++) {
-        I2C_u8MstTxSSP1(*pu8WkData);
-        __delay_us(ST7032_DEF_WAIT);
-        pu8WkData++;
-    }
-    // XgbvRfBV
-    I2C_vMstStopSSP1();
-    // J[\ʒüړ
-    stStateSSP1.u8CursorPos =
-            (stStateSSP1.u8CursorPos + (pu8WkData - pcData)) % 80;
+static uint8 u8SetDDAddrCmd(uint8 u8Pos) {
+    // カーソルアドレスへ変換
+    uint8 u8Addr = (u8Pos / 40) * 0x40 + (u8Pos % 40);
+    return ST7032_CMD_SET_DD_ADDR | (u8Addr & 0x7F);
 }
 
 /*******************************************************************************
  *
- * NAME: ST7032_vWriteDataSSP2
+ * NAME: vResetCache
  *
- * DESCRIPTION:Write Data
+ * DESCRIPTION:Reset cached controller state
  *
  * PARAMETERS:      Name            RW  Usage
- *      uint8*      pcData          R   f[^̃|C^
- *      uint8       u8Len           R   zTCY 
+ * tsST7032_handle* psHandle       RW  LCDハンドル
  *
  * RETURNS:
  *
  * NOTES:
- * None.
+ * 次回の操作で必要なモード切替とアドレス設定が必ず送信される状態にする。
  * 
  ******************************************************************************/
-#ifdef SSP2STAT
-extern void ST7032_vWriteDataSSP2(uint8* pcData, uint8 u8Len) {
-    // X^[gRfBV̑M
-    I2C_u8MstStartSSP2(ST7032_I2C_ADDR, false);
-    // Rg[oCgif[^j̑M
-    I2C_u8MstTxSSP2(ST7032_CNTR_DATA);
-    // f[^̑M
-    uint8* pu8WkData = pcData;
-    uint8 u8Idx;
-    for (u8Idx = 0; u8Idx < u8Len; u8Idx++) {
-        I2C_u8MstTxSSP2(*pu8WkData);
-        __delay_us(ST7032_DEF_WAIT);
-        pu8WkData++;
+static void vResetCache(tsST7032_handle *psHandle) {
+    psHandle->u8FuncSet  = ST7032_STATE_UNKNOWN;
+    psHandle->u8DispCntr = ST7032_STATE_UNKNOWN;
+    psHandle->u8AddrMode = ST7032_STATE_UNKNOWN;
+}
+
+/*******************************************************************************
+ *
+ * NAME: vInvalidate
+ *
+ * DESCRIPTION:Invalidate cached controller state and shadow
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * LCDのDDRAMの内容が不明となった場合に、次回のST7032_vFlushで
+ * シャドウ表示データの全セルを送信し直す。
+ * 
+ ******************************************************************************/
+static void vInvalidate(tsST7032_handle *psHandle) {
+    vResetCache(psHandle);
+    vSetDirty(psHandle, 0, ST7032_SHADOW_SIZE, true);
+}
+
+/*******************************************************************************
+ *
+ * NAME: bNeedRestore
+ *
+ * DESCRIPTION:Check cursor restore
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * tsST7032_handle* psHandle       R   LCDハンドル
+ *
+ * RETURNS:
+ *     bool true:カーソル位置の復帰が必要
+ *
+ * NOTES:
+ * カーソル非表示の場合、アドレスカウンタは次の書き込みまで移動しなくてよい。
+ * 
+ ******************************************************************************/
+static bool bNeedRestore(tsST7032_handle *psHandle) {
+    // カーソル及びブリンクが非表示
+    if ((psHandle->u8DispCntr & 0x03) == 0x00) {
+        return false;
     }
-    // XgbvRfBV
-    I2C_vMstStopSSP2();
-    // J[\ʒüړ
-    stStateSSP2.u8CursorPos =
-            (stStateSSP2.u8CursorPos + (pu8WkData - pcData)) % 80;
+    // アドレスカウンタがカーソル位置と一致
+    return !(psHandle->u8AddrMode == ST7032_ADDR_DDRAM
+                && psHandle->u8Addr == psHandle->u8CursorPos);
 }
-#endif
 
 /*******************************************************************************
  *
- * NAME: ST7032_vWriteIconSSP1
+ * NAME: vSetBusy
  *
- * DESCRIPTION:ACȐ
+ * DESCRIPTION:Set busy period
  *
  * PARAMETERS:      Name            RW  Usage
- *       uint8      u8Addr          R   ICON Address
- *       uint8      u8Map           R   ICON Bit Map
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ *      uint16      u16Ticks        R   実行時間（Timer1カウント数）
  *
  * RETURNS:
  *
@@ -1107,38 +1403,45 @@ extern void ST7032_vWriteDataSSP2(uint8* pcData, uint8 u8Len) {
  * None.
  * 
  ******************************************************************************/
-extern void ST7032_vWriteIconSSP1(uint8 u8Addr, uint8 u8Map) {
-    // X^[gRfBV̑M
-    I2C_u8MstStartSSP1(ST7032_I2C_ADDR, false);
-	// CXgNVe[u`FWiIS=1j
-    vExecCmdSSP1(ST7032_CMD_FUNC_SET_EX);
-    __delay_us(ST7032_DEF_WAIT);
-	// R}h̑MiACRAhXj
-    vExecCmdSSP1(ST7032_CMD_SET_ICON_ADDR | (u8Addr & 0x0F));
-    __delay_us(ST7032_DEF_WAIT);
-    // CXgNVe[u`FWiIS=0j
-    vExecCmdSSP1(ST7032_CMD_FUNC_SET_DEF);
-    __delay_us(ST7032_DEF_WAIT);
-    // Rg[oCgif[^j̑M
-    I2C_u8MstTxSSP1(ST7032_CNTR_DATA);
-    // f[^̑M
-    I2C_u8MstTxSSP1(u8Map & 0x1F);
-    // Xgbvrbg;
-    I2C_vMstStopSSP1();
-    __delay_us(ST7032_DEF_WAIT);
-    // J[\ʒu߂
-    bSetCursorSSP1(stStateSSP1.u8CursorPos);
+static void vSetBusy(tsST7032_handle *psHandle, uint16 u16Ticks) {
+    psHandle->u16BusyEnd = timer1_u16GetTick() + u16Ticks;
 }
 
 /*******************************************************************************
  *
- * NAME: ST7032_vWriteIconSSP2
+ * NAME: u8CalcPaceCnt
  *
- * DESCRIPTION:ACȐ
+ * DESCRIPTION:Calculate pace count
  *
  * PARAMETERS:      Name            RW  Usage
- *       uint8      u8Addr          R   ICON Address
- *       uint8      u8Map           R   ICON Bit Map
+ *       uint8      u8Baud          R   SSPxADDの値（クロック分割値）
+ *
+ * RETURNS:
+ *     uint8 1バイト毎の待ち回数
+ *
+ * NOTES:
+ * 1バイトのワイヤ時間が命令実行時間に満たない場合に、不足分の待ち回数を返す。
+ * I2Cマスタの初期化後に呼び出す事。
+ * 
+ ******************************************************************************/
+static uint8 u8CalcPaceCnt(uint8 u8Baud) {
+    // ワイヤ時間が命令実行時間以上の場合は待ち不要
+    if (u8Baud >= ST7032_PACE_BAUD_MIN) {
+        return 0;
+    }
+    // 不足時間を待ち回数に換算（切り上げ）
+    uint16 u16Lack = ST7032_EXEC_TIME - ST7032_WIRE_TIME(u8Baud);
+    return (uint8)((u16Lack + ST7032_PACE_UNIT * 10 - 1) / (ST7032_PACE_UNIT * 10));
+}
+
+/*******************************************************************************
+ *
+ * NAME: vPace
+ *
+ * DESCRIPTION:Wait for instruction execution
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *       uint8      u8Cnt           R   待ち回数
  *
  * RETURNS:
  *
@@ -1146,113 +1449,178 @@ extern void ST7032_vWriteIconSSP1(uint8 u8Addr, uint8 u8Map) {
  * None.
  * 
  ******************************************************************************/
-#ifdef SSP2STAT
-extern void ST7032_vWriteIconSSP2(uint8 u8Addr, uint8 u8Map) {
-    // X^[gRfBV̑M
-    I2C_u8MstStartSSP2(ST7032_I2C_ADDR, false);
-	// CXgNVe[u`FWiIS=1j
-    vExecCmdSSP2(ST7032_CMD_FUNC_SET_EX);
-    __delay_us(ST7032_DEF_WAIT);
-	// R}h̑MiACRAhXj
-    vExecCmdSSP2(ST7032_CMD_SET_ICON_ADDR | (u8Addr & 0x0F));
-    __delay_us(ST7032_DEF_WAIT);
-    // CXgNVe[u`FWiIS=0j
-    vExecCmdSSP2(ST7032_CMD_FUNC_SET_DEF);
-    __delay_us(ST7032_DEF_WAIT);
-    // Rg[oCgif[^j̑M
-    I2C_u8MstTxSSP2(ST7032_CNTR_DATA);
-    // f[^̑M
-    I2C_u8MstTxSSP2(u8Map & 0x1F);
-    // Xgbvrbg;
-    I2C_vMstStopSSP2();
-    __delay_us(ST7032_DEF_WAIT);
-    // J[\ʒu߂
-    bSetCursorSSP2(stStateSSP2.u8CursorPos);
+static void vPace(uint8 u8Cnt) {
+    for (; u8Cnt > 0; u8Cnt--) {
+        __delay_us(ST7032_PACE_UNIT);
+    }
 }
-#endif
 
-/******************************************************************************/
-/***        Local Functions                                                 ***/
-/******************************************************************************/
+/*******************************************************************************
+ *
+ * NAME: vClearShadow
+ *
+ * DESCRIPTION:Clear shadow
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * クリアディスプレイ後のDDRAMと同じく空白文字で初期化する。
+ * 
+ ******************************************************************************/
+static void vClearShadow(tsST7032_handle *psHandle) {
+    uint8 u8Idx;
+    for (u8Idx = 0; u8Idx < ST7032_SHADOW_SIZE; u8Idx++) {
+        psHandle->u8Shadow[u8Idx] = ST7032_CHAR_SPACE;
+    }
+    for (u8Idx = 0; u8Idx < sizeof(psHandle->u8DirtyMap); u8Idx++) {
+        psHandle->u8DirtyMap[u8Idx] = 0x00;
+    }
+}
 
 /*******************************************************************************
  *
- * NAME: vExecCmdSSP1
+ * NAME: bSetShadow
  *
- * DESCRIPTION:LCDCXgNV̎s
+ * DESCRIPTION:Set shadow
  *
  * PARAMETERS:      Name            RW  Usage
- *       uint8      u8Cmd           R   CXgNV      
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ *       uint8      u8RowNo         R   Row No
+ *       uint8      u8ColNo         R   Column No
+ *      uint8*      pu8Data         R   データのポインタ
+ *      uint8       u8Len           R   配列サイズ
  *
  * RETURNS:
+ *     bool true:設定成功、false:設定失敗
  *
  * NOTES:
  * None.
  * 
  ******************************************************************************/
-static void vExecCmdSSP1(uint8 u8Cmd) {
-    // Rg[oCgiR}hj̑M
-    I2C_u8MstTxSSP1(ST7032_CNTR_CMD | 0x80);
-    // R}h̑M
-    I2C_u8MstTxSSP1(u8Cmd);
+static bool bSetShadow(tsST7032_handle *psHandle,
+        uint8 u8RowNo, uint8 u8ColNo, uint8* pu8Data, uint8 u8Len) {
+    // 位置判定
+    if (u8RowNo > ST7032_ROW_MAX || u8ColNo >= ST7032_SHADOW_COL_SIZE) {
+        return false;
+    }
+    // 桁数を超える部分の切り捨て
+    if (u8Len > ST7032_SHADOW_COL_SIZE - u8ColNo) {
+        u8Len = ST7032_SHADOW_COL_SIZE - u8ColNo;
+    }
+    // 変更セルの記録
+    uint8 u8Idx = u8RowNo * ST7032_SHADOW_COL_SIZE + u8ColNo;
+    uint8 u8EndIdx = u8Idx + u8Len;
+    for (; u8Idx < u8EndIdx; u8Idx++) {
+        if (psHandle->u8Shadow[u8Idx] != *pu8Data) {
+            psHandle->u8Shadow[u8Idx] = *pu8Data;
+            psHandle->u8DirtyMap[u8Idx >> 3] |= (0x01 << (u8Idx & 0x07));
+        }
+        pu8Data++;
+    }
+    // 設定成功
+    return true;
 }
 
 /*******************************************************************************
  *
- * NAME: vExecCmdSSP2
+ * NAME: vSyncShadow
  *
- * DESCRIPTION:LCDCXgNV̎s
+ * DESCRIPTION:Synchronize shadow with written data
  *
  * PARAMETERS:      Name            RW  Usage
- *       uint8      u8Cmd           R   CXgNV      
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ *      uint8*      pu8Data         R   送信済みデータのポインタ
+ *      uint8       u8Len           R   配列サイズ
  *
  * RETURNS:
  *
  * NOTES:
- * None.
+ * カーソル位置から直接書き込んだデータをシャドウへ反映し、カーソル位置を進める。
  * 
  ******************************************************************************/
-#ifdef SSP2STAT
-static void vExecCmdSSP2(uint8 u8Cmd) {
-    // Rg[oCgiR}hj̑M
-    I2C_u8MstTxSSP2(ST7032_CNTR_CMD | 0x80);
-    // R}h̑M
-    I2C_u8MstTxSSP2(u8Cmd);
+static void vSyncShadow(tsST7032_handle *psHandle, uint8* pu8Data, uint8 u8Len) {
+    uint8 u8Pos = psHandle->u8CursorPos;
+    uint8 u8ColNo;
+    uint8 u8Idx;
+    for (; u8Len > 0; u8Len--) {
+        // シャドウの範囲内のセルのみ反映
+        u8ColNo = u8Pos % 40;
+        if (u8ColNo < ST7032_SHADOW_COL_SIZE) {
+            u8Idx = (u8Pos / 40) * ST7032_SHADOW_COL_SIZE + u8ColNo;
+            psHandle->u8Shadow[u8Idx] = *pu8Data;
+            psHandle->u8DirtyMap[u8Idx >> 3] &= ~(0x01 << (u8Idx & 0x07));
+        }
+        u8Pos = (u8Pos + 1) % 80;
+        pu8Data++;
+    }
+    // カーソル位置とアドレスカウンタの移動
+    psHandle->u8CursorPos = u8Pos;
+    psHandle->u8AddrMode  = ST7032_ADDR_DDRAM;
+    psHandle->u8Addr      = u8Pos;
 }
-#endif
 
 /*******************************************************************************
  *
- * NAME: vExecCmdEndSSP1
+ * NAME: u8SearchRun
  *
- * DESCRIPTION:Execute Command and Stop End
+ * DESCRIPTION:Search dirty run
  *
  * PARAMETERS:      Name            RW  Usage
- *       uint8      u8Cmd           R   CXgNV      
+ * tsST7032_handle* psHandle       R   LCDハンドル
+ *      uint8*      pu8Idx          RW  検索開始インデックス／ランの先頭
  *
  * RETURNS:
+ *     uint8 ランの長さ（0:更新セル無し）
  *
  * NOTES:
- * None.
+ * 未変更セルの間隔がST7032_RUN_GAP_MAX以下の更新セルは１つのランに結合する。
+ * ランは行を跨がない。
  * 
  ******************************************************************************/
-static void vExecCmdEndSSP1(uint8 u8Cmd) {
-    // Rg[oCgiR}hj̑M
-    I2C_u8MstTxSSP1(ST7032_CNTR_CMD);
-    // R}h̑M
-    I2C_u8MstTxSSP1(u8Cmd);
-    // XgbvRfBV
-    I2C_vMstStopSSP1();
+static uint8 u8SearchRun(tsST7032_handle *psHandle, uint8* pu8Idx) {
+    uint8 u8Idx = *pu8Idx;
+    uint8 u8RowEnd;
+    uint8 u8Last;
+    // 先頭の更新セルを検索
+    while (u8Idx < ST7032_SHADOW_SIZE) {
+        if (psHandle->u8DirtyMap[u8Idx >> 3] & (0x01 << (u8Idx & 0x07))) {
+            break;
+        }
+        u8Idx++;
+    }
+    if (u8Idx >= ST7032_SHADOW_SIZE) {
+        return 0;
+    }
+    *pu8Idx = u8Idx;
+    // 行末の算出
+    u8RowEnd = (u8Idx / ST7032_SHADOW_COL_SIZE + 1) * ST7032_SHADOW_COL_SIZE;
+    // 終端の更新セルを検索
+    u8Last = u8Idx;
+    for (u8Idx++; u8Idx < u8RowEnd; u8Idx++) {
+        if ((uint8)(u8Idx - u8Last) > ST7032_RUN_GAP_MAX + 1) {
+            break;
+        }
+        if (psHandle->u8DirtyMap[u8Idx >> 3] & (0x01 << (u8Idx & 0x07))) {
+            u8Last = u8Idx;
+        }
+    }
+    return u8Last - *pu8Idx + 1;
 }
 
 /*******************************************************************************
  *
- * NAME: vExecCmdEndSSP2
+ * NAME: vSetDirty
  *
- * DESCRIPTION:Execute Command and Stop End
+ * DESCRIPTION:Set dirty flags
  *
  * PARAMETERS:      Name            RW  Usage
- *       uint8      u8Cmd           R   CXgNV      
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ *      uint8       u8Idx           R   シャドウ表示データの先頭インデックス
+ *      uint8       u8Len           R   セル数
+ *      bool        bDirty          R   true:更新セルとする、false:反映済みとする
  *
  * RETURNS:
  *
@@ -1260,79 +1628,177 @@ static void vExecCmdEndSSP1(uint8 u8Cmd) {
  * None.
  * 
  ******************************************************************************/
+static void vSetDirty(tsST7032_handle *psHandle, uint8 u8Idx, uint8 u8Len, bool bDirty) {
+    uint8 u8EndIdx = u8Idx + u8Len;
+    for (; u8Idx < u8EndIdx; u8Idx++) {
+        if (bDirty) {
+            psHandle->u8DirtyMap[u8Idx >> 3] |= (0x01 << (u8Idx & 0x07));
+        } else {
+            psHandle->u8DirtyMap[u8Idx >> 3] &= ~(0x01 << (u8Idx & 0x07));
+        }
+    }
+}
+
+/*******************************************************************************
+ *
+ * NAME: vSubmitRun
+ *
+ * DESCRIPTION:Submit shadow run
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ *       uint8      u8Idx           R   シャドウ表示データの先頭インデックス
+ *       uint8      u8Len           R   ランの長さ
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * ランを１回の非同期トランザクションとして登録する。データはシャドウから直接
+ * 送信し、アドレスカウンタが一致しない場合のみカーソル設定をヘッダに含める。
+ * 送信結果を待たずに更新セルとアドレスカウンタを更新し、失敗した場合は
+ * 完了通知で更新セルに戻す。主処理と完了通知（割り込み内）から呼び出す。
+ * 
+ ******************************************************************************/
 #ifdef SSP2STAT
-static void vExecCmdEndSSP2(uint8 u8Cmd) {
-    // Rg[oCgiR}hj̑M
-    I2C_u8MstTxSSP2(ST7032_CNTR_CMD);
-    // R}h̑M
-    I2C_u8MstTxSSP2(u8Cmd);
-    // XgbvRfBV
-    I2C_vMstStopSSP2();
+static void vSubmitRun(tsST7032_handle *psHandle, uint8 u8Idx, uint8 u8Len) {
+    tsI2C_MstTrans *psTrans = &psHandle->sTrans;
+    // カーソル位置（通し番号）へ変換
+    uint8 u8Pos = (u8Idx / ST7032_SHADOW_COL_SIZE) * 40
+                    + (u8Idx % ST7032_SHADOW_COL_SIZE);
+    // カーソル設定（アドレスカウンタが一致している場合は省略）
+    if (psHandle->u8AddrMode == ST7032_ADDR_DDRAM && psHandle->u8Addr == u8Pos) {
+        psTrans->pu8TxHead   = &psHandle->u8TxHead[2];
+        psTrans->u8TxHeadLen = 1;
+    } else {
+        psHandle->u8TxHead[0] = ST7032_CNTR_CMD | ST7032_CNTR_CO;
+        psHandle->u8TxHead[1] = u8SetDDAddrCmd(u8Pos);
+        psTrans->pu8TxHead    = psHandle->u8TxHead;
+        psTrans->u8TxHeadLen  = 3;
+    }
+    // データ
+    psTrans->pu8TxData = &psHandle->u8Shadow[u8Idx];
+    psTrans->u8TxLen   = u8Len;
+    psHandle->u8FlushIdx = u8Idx;
+    // 更新セルのクリアとアドレスカウンタの移動
+    vSetDirty(psHandle, u8Idx, u8Len, false);
+    psHandle->u8AddrMode = ST7032_ADDR_DDRAM;
+    psHandle->u8Addr     = (u8Pos + u8Len) % 80;
+    // トランザクション登録
+    if (!I2C_bMstSubmitSSP2(psTrans)) {
+        // 登録できない場合は更新セルに戻して終了
+        vSetDirty(psHandle, u8Idx, u8Len, true);
+        vResetCache(psHandle);
+        psHandle->bFlushing = false;
+    }
 }
 #endif
 
 /*******************************************************************************
  *
- * NAME: bSetCursorSSP1
+ * NAME: vSubmitRestore
  *
- * DESCRIPTION:Move cursor
+ * DESCRIPTION:Submit cursor restore
  *
  * PARAMETERS:      Name            RW  Usage
- *       uint8      u8Pos           R   Cursor Position
+ * tsST7032_handle* psHandle       RW  LCDハンドル
  *
  * RETURNS:
- *     bool true:ݒ萬Afalse:ݒ莸s
  *
  * NOTES:
- * None.
+ * カーソル設定のみの非同期トランザクションを登録する。完了通知から呼び出す。
  * 
  ******************************************************************************/
-static bool bSetCursorSSP1(uint8 u8Pos) {
-    // J[\ݒ̉ۂ𔻒
-    stStateSSP1.u8CursorPos = u8Pos;
-    // J[\AhX֕ϊ
-    uint8 u8Addr = (u8Pos / 40) * 0x40 + (u8Pos % 40);
-    // X^[gRfBV̑M
-    I2C_u8MstStartSSP1(ST7032_I2C_ADDR, false);
-    // J[\ݒ
-    vExecCmdEndSSP1(ST7032_CMD_SET_DD_ADDR | (u8Addr & 0x7F));
-    __delay_us(ST7032_DEF_WAIT);
-    // ݒ萬
-    return true;
+#ifdef SSP2STAT
+static void vSubmitRestore(tsST7032_handle *psHandle) {
+    tsI2C_MstTrans *psTrans = &psHandle->sTrans;
+    psHandle->u8TxHead[0] = ST7032_CNTR_CMD;
+    psHandle->u8TxHead[1] = u8SetDDAddrCmd(psHandle->u8CursorPos);
+    psTrans->pu8TxHead    = psHandle->u8TxHead;
+    psTrans->u8TxHeadLen  = 2;
+    psTrans->pu8TxData    = NULL;
+    psTrans->u8TxLen      = 0;
+    psHandle->u8AddrMode  = ST7032_ADDR_DDRAM;
+    psHandle->u8Addr      = psHandle->u8CursorPos;
+    // トランザクション登録
+    if (!I2C_bMstSubmitSSP2(psTrans)) {
+        vResetCache(psHandle);
+        psHandle->bFlushing = false;
+    }
 }
+#endif
 
 /*******************************************************************************
  *
- * NAME: bSetCursorSSP2
+ * NAME: vFlushDone
  *
- * DESCRIPTION:Move cursor
+ * DESCRIPTION:Flush transaction completion
  *
  * PARAMETERS:      Name            RW  Usage
- *       uint8      u8Pos           R   Cursor Position
+ * tsI2C_MstTrans*  psTrans        RW  トランザクション記述子（LCDハンドルの先頭）
  *
  * RETURNS:
- *     bool true:ݒ萬Afalse:ݒ莸s
  *
  * NOTES:
- * None.
+ * 割り込み内で実行される。次の更新ランが有れば登録し、無ければカーソル位置の
+ * 復帰を登録して非同期送信を終了する。NACKやバスエラーの場合は送信できなかった
+ * ランを更新セルに戻し、コントローラの状態を破棄して終了する。
  * 
  ******************************************************************************/
 #ifdef SSP2STAT
-static bool bSetCursorSSP2(uint8 u8Pos) {
-    // J[\ݒ̉ۂ𔻒
-    stStateSSP2.u8CursorPos = u8Pos;
-    // J[\AhX֕ϊ
-    uint8 u8Addr = (u8Pos / 40) * 0x40 + (u8Pos % 40);
-    // X^[gRfBV̑M
-    I2C_u8MstStartSSP2(ST7032_I2C_ADDR, false);
-    // J[\ݒ
-    vExecCmdEndSSP2(ST7032_CMD_SET_DD_ADDR | (u8Addr & 0x7F));
-    __delay_us(ST7032_DEF_WAIT);
-    // ݒ萬
-    return true;    
+static void vFlushDone(tsI2C_MstTrans *psTrans) {
+    tsST7032_handle *psHandle = (tsST7032_handle*)psTrans;
+    // 送信失敗
+    if (psTrans->u8Status != I2C_TRANS_COMPLETE) {
+        vSetDirty(psHandle, psHandle->u8FlushIdx, psTrans->u8TxLen, true);
+        vResetCache(psHandle);
+        psHandle->bFlushing = false;
+        return;
+    }
+    // カーソル位置の復帰完了
+    if (psTrans->u8TxLen == 0) {
+        vSetBusy(psHandle, ST7032_EXEC_TICKS);
+        psHandle->bFlushing = false;
+        return;
+    }
+    // 次の更新ラン
+    uint8 u8Idx = psHandle->u8FlushIdx + psTrans->u8TxLen;
+    uint8 u8Len = u8SearchRun(psHandle, &u8Idx);
+    if (u8Len > 0) {
+        vSubmitRun(psHandle, u8Idx, u8Len);
+        return;
+    }
+    // カーソル位置を戻す（カーソル表示中の場合のみ）
+    if (bNeedRestore(psHandle)) {
+        vSubmitRestore(psHandle);
+        return;
+    }
+    psHandle->bFlushing = false;
 }
 #endif
 
+/*******************************************************************************
+ *
+ * NAME: vWaitFlush
+ *
+ * DESCRIPTION:Wait flush completion
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * tsST7032_handle* psHandle       RW  LCDハンドル
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 非同期送信中の場合は、全てのランとカーソル位置の復帰の完了まで待つ。
+ * 
+ ******************************************************************************/
+static void vWaitFlush(tsST7032_handle *psHandle) {
+#ifdef SSP2STAT
+    if (psHandle->bFlushing) {
+        I2C_vMstDrainSSP2();
+    }
+#endif
+}
+
 /******************************************************************************/
 /***        END OF FILE                                                     ***/
 /******************************************************************************/
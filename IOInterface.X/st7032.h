@@ -29,18 +29,71 @@ extern "C" {
 /******************************************************************************/
 #include <xc.h>
 #include "libcom.h"
+#include "i2cUtil.h"
 
 /******************************************************************************/
 /***       Macro Definitions                                                ***/
 /******************************************************************************/
-/** RgXgől */
+/** コントラスト最大値 */
 #define ST7032_CONTRAST_MAX     (63)
 #define ST7032_ROW_MAX          (1)
 #define ST7032_COL_MAX          (39)
 
+/** コマンドリストのコントロールバイト（コマンド） */
+#define ST7032_LIST_CMD         (0x80)
+/** コマンドリストのコントロールバイト（データ） */
+#define ST7032_LIST_DATA        (0xC0)
+
+/** LCDのI2Cアドレス */
+#define ST7032_I2C_ADDR         (0x3E)
+
+/** シャドウ表示データの桁数（表示領域外の桁は保持しない） */
+#ifndef ST7032_SHADOW_COL_SIZE
+#define ST7032_SHADOW_COL_SIZE  (40)
+#endif
+/** シャドウ表示データのサイズ */
+#define ST7032_SHADOW_SIZE      ((ST7032_ROW_MAX + 1) * ST7032_SHADOW_COL_SIZE)
+
 /******************************************************************************/
 /***        Type Definitions                                                ***/
 /******************************************************************************/
+/**
+ * 構造体：LCDハンドル（LCD毎の接続先と状態情報）
+ */
+typedef struct {
+    // 非同期送信のトランザクション記述子（完了通知からハンドルを参照する為に先頭に配置）
+    tsI2C_MstTrans sTrans;
+    // I2Cバス記述子（I2C_BUS_SSP1/I2C_BUS_SSP2）
+    const tsI2C_Bus *psBus;
+    // I2Cアドレス
+    uint8 u8Address;
+	// カーソル位置
+	uint8 u8CursorPos;
+    // ICON display(1bit). booster circuit(1bit). Contrast(6bit).
+	uint8 u8Settings;
+    // 1バイト毎の待ち回数（ST7032_PACE_UNIT単位）
+    uint8 u8PaceCnt;
+    // 命令実行の完了予定時刻（Timer1のカウント値）
+    uint16 u16BusyEnd;
+    // 現在のファンクション設定（インストラクションテーブル）
+    uint8 u8FuncSet;
+    // 現在のディスプレイ設定
+    uint8 u8DispCntr;
+    // アドレスカウンタの対象（DDRAM/CGRAM/ICON RAM）
+    uint8 u8AddrMode;
+    // アドレスカウンタの値（DDRAMはカーソル位置と同じ0-79の通し番号）
+    uint8 u8Addr;
+    // シャドウ表示データ（LCDへ反映済み又は反映予定のDDRAMの内容）
+    uint8 u8Shadow[ST7032_SHADOW_SIZE];
+    // 更新セルのビットマップ（1:未反映）
+    uint8 u8DirtyMap[(ST7032_SHADOW_SIZE + 7) / 8];
+    // 非同期送信のヘッダ（コマンドのコントロールバイト、コマンド、データのコントロールバイト）
+    uint8 u8TxHead[3];
+    // 非同期送信中のランの先頭インデックス
+    uint8 u8FlushIdx;
+    // 非同期送信中フラグ
+    volatile bool bFlushing;
+} tsST7032_handle;
 
 /******************************************************************************/
 /***        Exported Variables                                              ***/
@@ -50,106 +103,76 @@ extern "C" {
 /***        Exported Functions                                              ***/
 /******************************************************************************/
 // LCD Initialize
-extern void ST7032_vInitSSP1();
-#ifdef SSP2STAT
-extern void ST7032_vInitSSP2();
-#endif
+extern void ST7032_vInit(tsST7032_handle *psHandle, const tsI2C_Bus *psBus,
+                         uint8 u8Address);
 
 // LCD Setting
-extern void ST7032_vDispSettingSSP1(bool bDisp, bool bCursor, bool bBlink);
-#ifdef SSP2STAT
-extern void ST7032_vDispSettingSSP2(bool bDisp, bool bCursor, bool bBlink);
-#endif
+extern void ST7032_vDispSetting(tsST7032_handle *psHandle,
+                                bool bDisp, bool bCursor, bool bBlink);
 
 // Icon Display Setting
-extern void ST7032_vDispIconSSP1(bool bDisp);
-#ifdef SSP2STAT
-extern void ST7032_vDispIconSSP2(bool bDisp);
-#endif
+extern void ST7032_vDispIcon(tsST7032_handle *psHandle, bool bDisp);
 
 // LCD Contrast
-extern void ST7032_vSetContrastSSP1(uint8 u8Contrast);
-#ifdef SSP2STAT
-extern void ST7032_vSetContrastSSP2(uint8 u8Contrast);
-#endif
+extern void ST7032_vSetContrast(tsST7032_handle *psHandle, uint8 u8Contrast);
 
 // Clear Display
-extern void ST7032_vClearDispSSP1();
-#ifdef SSP2STAT
-extern void ST7032_vClearDispSSP2();
-#endif
+extern void ST7032_vClearDisp(tsST7032_handle *psHandle);
 
 // Clear Icon
-extern void ST7032_vClearIconSSP1();
-#ifdef SSP2STAT
-extern void ST7032_vClearIconSSP2();
-#endif
+extern void ST7032_vClearIcon(tsST7032_handle *psHandle);
 
 // Get cursor row no
-extern uint8 ST7032_u8GetCursorRowNoSSP1();
-#ifdef SSP2STAT
-extern uint8 ST7032_u8GetCursorRowNoSSP2();
-#endif
+extern uint8 ST7032_u8GetCursorRowNo(tsST7032_handle *psHandle);
 
 // Get cursor column no
-extern uint8 ST7032_u8GetCursorColNoSSP1();
-#ifdef SSP2STAT
-extern uint8 ST7032_u8GetCursorColNoSSP2();
-#endif
+extern uint8 ST7032_u8GetCursorColNo(tsST7032_handle *psHandle);
 
 // Move cursor
-extern bool ST7032_bSetCursorSSP1(uint8 u8RowNo, uint8 u8ColNo);
-#ifdef SSP2STAT
-extern bool ST7032_bSetCursorSSP2(uint8 u8RowNo, uint8 u8ColNo);
-#endif
+extern bool ST7032_bSetCursor(tsST7032_handle *psHandle, uint8 u8RowNo, uint8 u8ColNo);
 
 // Move cursor to left
-extern bool ST7032_bCursorLeftSSP1();
-#ifdef SSP2STAT
-extern bool ST7032_bCursorLeftSSP2();
-#endif
+extern bool ST7032_bCursorLeft(tsST7032_handle *psHandle);
 
 // Move cursor to right
-extern bool ST7032_bCursorRightSSP1();
-#ifdef SSP2STAT
-extern bool ST7032_bCursorRightSSP2();
-#endif
+extern bool ST7032_bCursorRight(tsST7032_handle *psHandle);
 
 // Move cursor to top
-#define ST7032_vCursorTopSSP1() ST7032_bSetCursorSSP1(0, 0)
-#ifdef SSP2STAT
-#define ST7032_vCursorTopSSP2() ST7032_bSetCursorSSP2(0, 0)
-#endif
+#define ST7032_vCursorTop(psHandle) ST7032_bSetCursor(psHandle, 0, 0)
 
 // Write CGRAM
-extern void ST7032_vWriteCGRAMSSP1(uint8 u8CharNo, uint8* pu8BitMap);
-#ifdef SSP2STAT
-extern void ST7032_vWriteCGRAMSSP2(uint8 u8CharNo, uint8* pu8BitMap);
-#endif
+extern void ST7032_vWriteCGRAM(tsST7032_handle *psHandle, uint8 u8CharNo, uint8* pu8BitMap);
 
 // Write Character
-extern void ST7032_vWriteCharSSP1(char cData);
-#ifdef SSP2STAT
-extern void ST7032_vWriteCharSSP2(char cData);
-#endif
+extern void ST7032_vWriteChar(tsST7032_handle *psHandle, char cData);
 
 // Write String
-extern void ST7032_vWriteStringSSP1(char* pcStr);
-#ifdef SSP2STAT
-extern void ST7032_vWriteStringSSP2(char* pcStr);
-#endif
+extern void ST7032_vWriteString(tsST7032_handle *psHandle, char* pcStr);
 
 // Write Data
-extern void ST7032_vWriteDataSSP1(uint8* pu8Data, uint8 u8Len);
-#ifdef SSP2STAT
-extern void ST7032_vWriteDataSSP2(uint8* pu8Data, uint8 u8Len);
-#endif
+extern void ST7032_vWriteData(tsST7032_handle *psHandle, uint8* pu8Data, uint8 u8Len);
 
 // Write ICON
-extern void ST7032_vWriteIconSSP1(uint8 u8Addr, uint8 u8Map);
-#ifdef SSP2STAT
-extern void ST7032_vWriteIconSSP2(uint8 u8Addr, uint8 u8Map);
-#endif
+extern void ST7032_vWriteIcon(tsST7032_handle *psHandle, uint8 u8Addr, uint8 u8Map);
+
+// Write ICONs
+extern void ST7032_vWriteIcons(tsST7032_handle *psHandle, uint8* pu8Map, uint16 u16Mask);
+
+// Execute Command List
+extern void ST7032_vExecList(tsST7032_handle *psHandle, const uint8* pu8List, uint8 u8Cnt);
+
+// Set Shadow Display Data
+extern bool ST7032_bSetShadow(tsST7032_handle *psHandle, uint8 u8RowNo, uint8 u8ColNo,
+                              uint8* pu8Data, uint8 u8Len);
+
+// Flush Shadow Display Data
+extern void ST7032_vFlush(tsST7032_handle *psHandle);
+
+// Check flush busy
+extern bool ST7032_bFlushBusy(tsST7032_handle *psHandle);
+
+// Invalidate cached state
+extern void ST7032_vInvalidate(tsST7032_handle *psHandle);
 
 #ifdef	__cplusplus
 }
@@ -21,41 +21,41 @@
 /***        Include files                                                   ***/
 /******************************************************************************/
 #include <xc.h>
-#include "setting.h"            // ݒl
-#include "libcom.h"             // ʒ`
-#include "i2cUtil.h"            // I2C֐Cup
-#include "keypad.h"             // L[pbh
+#include "setting.h"            // 設定値
+#include "libcom.h"             // 共通定義
+#include "i2cUtil.h"            // I2C関数ライブラリ用
+#include "keypad.h"             // キーパッド
 #include "st7032.h"             // LCD
 
 /******************************************************************************/
 /***       Macro Definitions                                                ***/
 /******************************************************************************/
-// RtBOP
-#pragma config FOSC  = INTOSC   // NbN(INTOSC:8MHz)gp
-#pragma config WDTE  = OFF      // EIb`hbO^C}[(OFF)
-#pragma config PWRTE = ON       // dON64msɃvOJn(ON)
-#pragma config MCLRE = OFF      // OZbgM͎gpɃfW^(RA3)sƂ(OFF)
-#pragma config CP    = OFF      // vO[ی삵Ȃ(OFF)
-#pragma config CPD   = OFF      // EEPROM̃f[^ǂݏoiOFFj
-#pragma config BOREN = ON       // dd~(BORVݒȉ)펞Ď@\ON(ON)
-#pragma config CLKOUTEN = OFF   // CLKOUTsRA4sŎgp(OFF)
-#pragma config IESO  = OFF      // ONbNւ̐ؑւł̋N͂Ȃ(OFF)
-#pragma config FCMEN = OFF      // NbNĎȂ(OFF)
+// コンフィグ１
+#pragma config FOSC  = INTOSC   // 内部クロック(INTOSC:8MHz)使用する
+#pragma config WDTE  = OFF      // ウオッチドッグタイマー無し(OFF)
+#pragma config PWRTE = ON       // 電源ONから64ms後にプログラムを開始する(ON)
+#pragma config MCLRE = OFF      // 外部リセット信号は使用せずにデジタル入力(RA3)ピンとする(OFF)
+#pragma config CP    = OFF      // プログラムメモリーを保護しない(OFF)
+#pragma config CPD   = OFF      // EEPROMのデータ読み出し許可（OFF）
+#pragma config BOREN = ON       // 電源電圧降下(BORV設定以下)常時監視機能ON(ON)
+#pragma config CLKOUTEN = OFF   // CLKOUTピンをRA4ピンで使用する(OFF)
+#pragma config IESO  = OFF      // 内部から外部クロックへの切替えでの起動はなし(OFF)
+#pragma config FCMEN = OFF      // 部クロック監視しない(OFF)
 
-// RtBOQ
-#pragma config WRT    = OFF     // Flash[ی삵Ȃ(OFF)
-#pragma config PLLEN  = OFF     // NbN32MHzł͓삳Ȃ(OFF)
-#pragma config STVREN = ON      // X^bNI[ot[A_[t[烊Zbg(ON)
-#pragma config BORV   = HI      // dd~펞Ďd(2.7V)ݒ(HI)
-#pragma config LVP    = OFF     // dvO~O@\gpȂ(OFF)
+// コンフィグ２
+#pragma config WRT    = OFF     // Flashメモリーを保護しない(OFF)
+#pragma config PLLEN  = OFF     // 動作クロックを32MHzでは動作させない(OFF)
+#pragma config STVREN = ON      // スタックがオーバフローやアンダーフローしたらリセットをする(ON)
+#pragma config BORV   = HI      // 電源電圧降下常時監視電圧(2.7V)設定(HI)
+#pragma config LVP    = OFF     // 低電圧プログラミング機能使用しない(OFF)
 
-// 16iւ̕ϊ
+// 16進数文字への変換
 #define hexToChar(val) HEX_LIST[val & 0x0F]
 
 // I2C 7bit address
 #define	I2C_ADDR    (8)
 
-// sFd֌W
+// ピン：電源関係
 #define PIN_POWER           RB0
 #define PIN_BACK_LIGHT      RB3
 
@@ -63,39 +63,47 @@
 /***        Type Definitions                                                ***/
 /******************************************************************************/
 /**
- * ̓[h
+ * 入力モード
  */
 typedef enum {
-    INPUT_MODE_NONE         = 0x00, // ͖
-    INPUT_MODE_CURRENT      = 0x01, // ݒl[h
-    INPUT_MODE_FINAL        = 0x02, // ŏIl[h
-    INPUT_MODE_BUFFERING    = 0x03  // obt@O
+    INPUT_MODE_NONE         = 0x00, // 入力無効
+    INPUT_MODE_CURRENT      = 0x01, // 現在値モード
+    INPUT_MODE_FINAL        = 0x02, // 最終値モード
+    INPUT_MODE_BUFFERING    = 0x03  // バッファリング
 } teInputMode;
 
 
 /******************************************************************************/
 /***        Local Function Prototypes                                       ***/
 /******************************************************************************/
-// ^C}[荞ݏ
+// タイマー割り込み処理
 static void timer_vInterrupt();
-// I2C荞݂̃R[obN֐
-static void ssp1_vCallback(uint8 u8BusNo, uint8 u8EvtType);
-// I2C Test 01:݁iPoCgPʁj
+// I2C割り込みのコールバック関数
+static bool ssp1_bCallback(uint8 u8BusNo, uint8 u8EvtType);
+// I2C Test 01:書き込み（１バイト単位）
 static void ssp2_vI2CTest01();
-// I2C Test 02:݁ioCgPʁj
+// I2C Test 02:書き込み（複数バイト単位）
 static void ssp2_vI2CTest02();
-// I2C Test 03:ǂݍ݁iPoCgPʁj
+// I2C Test 03:読み込み（１バイト単位）
 static void ssp2_vI2CTest03();
-// I2C Test 03:ǂݍ݁ioCgPʁj
+// I2C Test 03:読み込み（複数バイト単位）
 static void ssp2_vI2CTest04();
-// LCD Test 01:`
+// I2C Test 05:非同期トランザクション
+static void ssp2_vI2CTest05();
+// I2C Test 06:完了通知からの非同期トランザクション登録
+static void ssp2_vI2CTest06();
+// I2C Test 06:完了通知
+static void ssp2_vI2CTest06Done(tsI2C_MstTrans *psTrans);
+// LCD Test 01:文字描画
 static void ssp2_vLCDTest01();
-// LCD Test 02:J[\ړ
+// LCD Test 02:カーソル移動
 static void ssp2_vLCDTest02();
 // LCD Test 03:CGRAM
 static void ssp2_vLCDTest03();
 // LCD Test 04:ICON
 static void ssp2_vLCDTest04();
+// LCD Test 05:シャドウ表示データ
+static void ssp2_vLCDTest05();
 // Keypad Test 01:
 static void ssp2_vKeypadTest01();
 // Keypad Test 02:
@@ -112,21 +120,31 @@ static void ssp2_vKeypadTest04();
 /******************************************************************************/
 /***        Local Variables                                                 ***/
 /******************************************************************************/
-// z
+// 文字配列
 static const char HEX_LIST[] = "0123456789ABCDEF";
 static const char KEY_LIST[] = "123A456B789C*0#D";
-// I2Cf[^
+// I2Cデータ
 static uint8 u8RxData;
-// ̓[h
+// 入力モード
 static teInputMode eInputMode;
-// L[l
+// キー値
 static uint8 u8KeyValue;
+// LCDハンドル
+static tsST7032_handle sLcd;
+// 非同期トランザクション（完了通知から登録）
+static tsI2C_MstTrans sChainTrans;
+// 完了通知の回数
+static uint8 u8DoneCnt;
+// 完了通知の順序（完了したトランザクションの書き込みデータ先頭）
+static uint8 u8DoneOrder[2];
+// 完了通知中の全割込み許可ビット
+static bool bDoneGie;
 
 /*******************************************************************************
  *
  * NAME: main
  *
- * DESCRIPTION:又
+ * DESCRIPTION:主処理
  *
  * PARAMETERS:      Name            RW  Usage
  *
@@ -137,82 +155,86 @@ static uint8 u8KeyValue;
  ******************************************************************************/
 void main() {
     //==========================================================================
-    // ^C}[уsݒ
+    // タイマーおよびピン設定
     //==========================================================================
-    OSCCON = 0b01111010;    // NbN16lgƂ
-    ANSELA = 0b00000000;    // AiOgpȂ(ׂăfW^I/OɊĂ)
-    ANSELB = 0b00000000;    // AiOgpȂ(ׂăfW^I/OɊĂ)
-    TRISA  = 0b00011100;    // SĂo̓[hƂ
-    TRISB  = 0b10110110;    // sRB1(SDA)/RB4(SCL)̂ݓ
-    PORTA  = 0b00000000;    // o̓s̏(SLOWɂ)
-    PORTB  = 0b00000000;    // o̓s̏(SLOWɂ)
+    OSCCON = 0b01111010;    // 内部クロックは16ＭＨｚとする
+    ANSELA = 0b00000000;    // アナログ使用しない(すべてデジタルI/Oに割当てる)
+    ANSELB = 0b00000000;    // アナログ使用しない(すべてデジタルI/Oに割当てる)
+    TRISA  = 0b00011100;    // 全てを出力モードとする
+    TRISB  = 0b10110110;    // ピンはRB1(SDA)/RB4(SCL)のみ入力
+    PORTA  = 0b00000000;    // 出力ピンの初期化(全てLOWにする)
+    PORTB  = 0b00000000;    // 出力ピンの初期化(全てLOWにする)
 
     //==========================================================================
-    // ^C}[ݒ
+    // タイマー設定
     // FOSC = 16MHz / 4
-    // JEgAbvTCN = FOSC / vXP[ = (16MHz / 4) / 128
-    // 1bԂ̊荞݉ = JEgAbvTCN / 256 = 128
+    // カウントアップサイクル = FOSC / プリスケーラ = (16MHz / 4) / 128
+    // 1秒間の割り込み回数 = カウントアップサイクル / 256 = 128回
     //==========================================================================
-    OPTION_REG = 0b00000110;    // NbNTIMER0gpAvXP[ 1:128
-    TMR0   = 0;                 // ^C}[0̏
-    TMR0IF = 0;                 // ^C}[0tO(T0IF)0ɂ
-    TMR0IE = 1;                 // ^C}[0(T0IE)
+    OPTION_REG = 0b00000110;    // 内部クロックでTIMER0を使用、プリスケーラ 1:128
+    TMR0   = 0;                 // タイマー0の初期化
+    TMR0IF = 0;                 // タイマー0割込フラグ(T0IF)を0にする
+    TMR0IE = 1;                 // タイマー0割込み(T0IE)を許可する
     
     //==========================================================================
-    // I2C
+    // I2C初期処理
     //==========================================================================
-    // SSP1:X[u[hł̏
-    I2C_vInitSlaveSSP1(I2C_ADDR, I2C_SLAVE_STD, ssp1_vCallback);
-    // SSP2:}X^[[hŏ
-    I2C_vInitMasterSSP2(I2C_MASTER_STD, I2C_CLK_DIV_STD_8MHZ);
+    // SSP1:スレーブモードでの初期化
+    I2C_vInitSlaveSSP1(I2C_ADDR, I2C_SLAVE_STD, ssp1_bCallback);
+    // SSP2:マスターモードで初期化
+    I2C_vInitMasterSSP2(I2C_MASTER_STD, I2C_CLK_DIV(I2C_BAUD_STD));
     
     //==========================================================================
-    // L[pbhݒ
+    // キーパッド設定
     //==========================================================================
     tsKEYPAD_status keypadSts;
-    // ẽs
+    // 各列のピン
     keypadSts.u16PinCols[0] = ID_PORTA | 0b00000100;
     keypadSts.u16PinCols[1] = ID_PORTA | 0b00001000;
     keypadSts.u16PinCols[2] = ID_PORTA | 0b00010000;
     keypadSts.u16PinCols[3] = ID_PORTB | 0b10000000;
-    // es̃s
+    // 各行のピン
     keypadSts.u16PinRows[0] = ID_PORTA | 0b00000010;
     keypadSts.u16PinRows[1] = ID_PORTA | 0b00000001;
     keypadSts.u16PinRows[2] = ID_PORTA | 0b10000000;
     keypadSts.u16PinRows[3] = ID_PORTA | 0b01000000;
     
-    // Ώۂ̃L[pbh
+    // 対象のキーパッドを初期化する
     KEYPAD_vInit(&keypadSts);
     
     //==========================================================================
-    // 荞݂̗L
+    // 割り込みの有効化
     //==========================================================================
-    PEIE = 1;   // ӑu荞ݗL
-    GIE  = 1;   // Sݏ
+    PEIE = 1;   // 周辺装置割り込み有効
+    GIE  = 1;   // 全割込み処理を許可する
 
     //==========================================================================
-    // LCD̏
+    // LCDの初期化処理
     //==========================================================================
-    // LCDsݒ菉
+    // LCDピン設定初期化
     PIN_POWER      = ON;
     PIN_BACK_LIGHT = OFF;
     __delay_ms(40);
-    // LCD
-    ST7032_vInitSSP2();
+    // LCD初期化処理
+    ST7032_vInit(&sLcd, I2C_BUS_SSP2, ST7032_I2C_ADDR);
 
     //==========================================================================
-    // eXgP[X
+    // テストケース処理
     //==========================================================================
-    // C[v
+    // メインループ
     while(true) {
-        // I2C Test 01:1oCgPʂ̏
+        // I2C Test 01:1バイト単位の書き込み
 //        ssp2_vI2CTest01();
-        // I2C Test 02:oCgPʂ̏
+        // I2C Test 02:複数バイト単位の書き込み
 //        ssp2_vI2CTest02();
-        // I2C Test 03:1oCgPʂ̓ǂݍ
+        // I2C Test 03:1バイト単位の読み込み
 //        ssp2_vI2CTest03();
-        // I2C Test 04:oCgPʂ̓ǂݍ
+        // I2C Test 04:複数バイト単位の読み込み
 //        ssp2_vI2CTest04();
+        // I2C Test 05:非同期トランザクションの書き込みと読み込み
+        ssp2_vI2CTest05();
+        // I2C Test 06:完了通知からの非同期トランザクション登録
+        ssp2_vI2CTest06();
         // LCD Test 01
         ssp2_vLCDTest01();
         // LCD Test 02
@@ -221,6 +243,8 @@ void main() {
         ssp2_vLCDTest03();
         // LCD Test 04
         ssp2_vLCDTest04();
+        // LCD Test 05
+        ssp2_vLCDTest05();
         // Keypad Test 01
 //        ssp2_vKeypadTest01();
         // Keypad Test 02
@@ -236,7 +260,7 @@ void main() {
  *
  * NAME: __interrupt(high_priority) ISR
  *
- * DESCRIPTION:荞ݏ
+ * DESCRIPTION:割り込み処理
  *
  * PARAMETERS:      Name            RW  Usage
  *
@@ -247,22 +271,23 @@ void main() {
  ******************************************************************************/
 void __interrupt(high_priority) ISR() {
     //==========================================================================
-    // ^C}[荞ݔ̏
+    // タイマー割り込み発生時の処理
     //==========================================================================
-    // ^C}[荞ݏ
+    // タイマー割り込み処理
     timer_vInterrupt();
     
     //==========================================================================
-    // SSP(I2C)荞ݔ̏
+    // SSP(I2C)割り込み発生時の処理
     //==========================================================================
     I2C_vSlaveIsrSSP1();
+    I2C_vMasterIsrSSP2();
 }
 
 /*******************************************************************************
  *
  * NAME: timer_vInterrupt
  *
- * DESCRIPTION:^C}[荞ݏ
+ * DESCRIPTION:タイマー割り込み処理
  *
  * PARAMETERS:      Name            RW  Usage
  *
@@ -272,30 +297,30 @@ void __interrupt(high_priority) ISR() {
  *  None.
  ******************************************************************************/
 static void timer_vInterrupt() {
-    // ^C}[O̊荞݂̗L𔻒
+    // タイマー０の割り込みの有無を判定
     if (TMR0IF != 1) {
         return;
     }
-    // ^C}[JE^
-    TMR0   = 0;                 // ^C}[0̃JE^
-    TMR0IF = 0;                 // ^C}[0tOZbg
-    // ̓[h
+    // タイマーカウンタ
+    TMR0   = 0;                 // タイマー0のカウンタ初期化
+    TMR0IF = 0;                 // タイマー0割込フラグをリセット
+    // 入力モード判定
     switch (eInputMode) {
-        // ͖
+        // 入力無効
         case INPUT_MODE_NONE:
             break;
-        // ݒl[h
+        // 現在値モード
         case INPUT_MODE_CURRENT:
             u8KeyValue = KEYPAD_u8Read();
             break;
-        // ŏIl[h
+        // 最終値モード
         case INPUT_MODE_FINAL:
-            // obt@XV
+            // バッファ更新
             KEYPAD_bUpdateBuffer();
             break;
-        // obt@O[h
+        // バッファリングモード
         case INPUT_MODE_BUFFERING:
-            // obt@XV
+            // バッファ更新
             KEYPAD_bUpdateBuffer();
             break;
         default:
@@ -305,60 +330,62 @@ static void timer_vInterrupt() {
 
 /*******************************************************************************
  *
- * NAME: ssp1_vCallback
+ * NAME: ssp1_bCallback
  *
- * DESCRIPTION:I2C荞݂̃R[obN֐
+ * DESCRIPTION:I2C割り込みのコールバック関数
  *
  * PARAMETERS:      Name            RW  Usage
  *      uint8       u8BusNo         R   Bus number
  *      uint8       u8EvtType       R   Event Type
  *
  * RETURNS:
+ *    bool true:SCLラインを開放する
  *
  * NOTES:
  * None.
  ******************************************************************************/
-static void ssp1_vCallback(uint8 u8BusNo, uint8 u8EvtType) {
+static bool ssp1_bCallback(uint8 u8BusNo, uint8 u8EvtType) {
     uint8 u8Data;
     switch (u8EvtType) {
         case I2C_SLV_EVT_WRITE_ADDR:
-            // ݗvAhXM
-            // AhXf[^ǂ݂
+            // 書き込み要求アドレス受信
+            // アドレスデータを空読みする
             u8Data = SSP1BUF;
             break;
         case I2C_SLV_EVT_WRITE_DATA:
-            // ݗvf[^M
-            // f[^Ǎ(ACKPICIɕԂ)
+            // 書き込み要求データ受信
+            // データを読込む(ACKはPICが自動的に返す)
             u8RxData = SSP1BUF;
             break;
         case I2C_SLV_EVT_READ_ADDR:
-            // ǂݏovAhXM
-            // AhXf[^ǂ݂
+            // 読み出し要求アドレス受信
+            // アドレスデータを空読みする
             u8Data = SSP1BUF;
-            // f[^ԐM
+            // データを返信
             SSP1BUF = u8RxData;
             u8RxData++;
             break;
         case I2C_SLV_EVT_READ_ACK:
-            // ǂݏovACKM
-            // Mf[^𑗐Mobt@ɃZbg
+            // 読み出し要求ACK応答受信
+            // 受信データを送信バッファにセット
             SSP1BUF = u8RxData;
             u8RxData++;
             break;
         case I2C_SLV_EVT_READ_NACK:
-            // ǂݏovNACKM
-            // ǂݏoɂAȂ
+            // 読み出し要求NACK応答受信
+            // 読み出し完了により、何もしない
             break;
         default:
             break;
     }
+    return true;
 }
 
 /*******************************************************************************
  *
  * NAME: ssp2_vI2CTest01
  *
- * DESCRIPTION:I2CeXgP[X
+ * DESCRIPTION:I2Cテストケース
  *
  * PARAMETERS:      Name            RW  Usage
  *
@@ -369,40 +396,40 @@ static void ssp1_vCallback(uint8 u8BusNo, uint8 u8EvtType) {
  ******************************************************************************/
 static void ssp2_vI2CTest01() { 
     //==========================================================================
-    // L[ǂݍ݃eXg
+    // キー読み込みテスト
     //==========================================================================
-    // J[\\
-    ST7032_vDispSettingSSP2(true, true, false);
-    // bZ[W
-    ST7032_bSetCursorSSP2(0, 0);
-    ST7032_vWriteStringSSP2("Test:I2C 01     ");
-    ST7032_bSetCursorSSP2(1, 0);
-    ST7032_vWriteStringSSP2("Tx 0x  ->Rx 0x  ");
+    // カーソル表示
+    ST7032_vDispSetting(&sLcd, true, true, false);
+    // メッセージ
+    ST7032_bSetCursor(&sLcd, 0, 0);
+    ST7032_vWriteString(&sLcd, "Test:I2C 01     ");
+    ST7032_bSetCursor(&sLcd, 1, 0);
+    ST7032_vWriteString(&sLcd, "Tx 0x  ->Rx 0x  ");
     
     //==========================================================================
-    // 1oCgPʂ̑MeXg
+    // 1バイト単位の送信テスト
     //==========================================================================
-    // f[^NA
+    // データクリア
     u8RxData = 0xFF;
     uint8 u8TxData;
     for (u8TxData = 0; u8TxData < 255; u8TxData++) {
-        // Mf[^\
-        ST7032_bSetCursorSSP2(1, 5);
-        ST7032_vWriteCharSSP2(HEX_LIST[u8TxData / 16]);
-        ST7032_vWriteCharSSP2(HEX_LIST[u8TxData % 16]);
-        // X^[gRfBV̑M
+        // 送信データ表示
+        ST7032_bSetCursor(&sLcd, 1, 5);
+        ST7032_vWriteChar(&sLcd, HEX_LIST[u8TxData / 16]);
+        ST7032_vWriteChar(&sLcd, HEX_LIST[u8TxData % 16]);
+        // スタートコンディションの送信
         I2C_u8MstStartSSP2(I2C_ADDR, false);
         I2C_u8MstTxSSP2(u8TxData);
         I2C_vMstStopSSP2();
-        // Mf[^mF
-        ST7032_bSetCursorSSP2(1, 14);
+        // 受信データ確認
+        ST7032_bSetCursor(&sLcd, 1, 14);
         if (u8RxData == u8TxData) {
-            ST7032_vWriteCharSSP2(HEX_LIST[u8RxData / 16]);
-            ST7032_vWriteCharSSP2(HEX_LIST[u8RxData % 16]);
+            ST7032_vWriteChar(&sLcd, HEX_LIST[u8RxData / 16]);
+            ST7032_vWriteChar(&sLcd, HEX_LIST[u8RxData % 16]);
         } else {
-            ST7032_vWriteStringSSP2("XX");
+            ST7032_vWriteString(&sLcd, "XX");
         }
-        // EFCg
+        // ウェイト
         __delay_ms(20);
     }
 }
@@ -411,7 +438,7 @@ static void ssp2_vI2CTest01() {
  *
  * NAME: ssp2_vI2CTest02
  *
- * DESCRIPTION:I2CeXgP[XAoCgPʂ̏݃eXg
+ * DESCRIPTION:I2Cテストケース、複数バイト単位の書き込みテスト
  *
  * PARAMETERS:      Name            RW  Usage
  *
@@ -422,42 +449,42 @@ static void ssp2_vI2CTest01() {
  ******************************************************************************/
 static void ssp2_vI2CTest02() { 
     //==========================================================================
-    // L[ǂݍ݃eXg
+    // キー読み込みテスト
     //==========================================================================
-    // J[\\
-    ST7032_vDispSettingSSP2(true, true, false);
-    // bZ[W
-    ST7032_bSetCursorSSP2(0, 0);
-    ST7032_vWriteStringSSP2("Test:I2C 02     ");
-    ST7032_bSetCursorSSP2(1, 0);
-    ST7032_vWriteStringSSP2("Tx 0x00->0xFF   ");
-    // EFCg
+    // カーソル表示
+    ST7032_vDispSetting(&sLcd, true, true, false);
+    // メッセージ
+    ST7032_bSetCursor(&sLcd, 0, 0);
+    ST7032_vWriteString(&sLcd, "Test:I2C 02     ");
+    ST7032_bSetCursor(&sLcd, 1, 0);
+    ST7032_vWriteString(&sLcd, "Tx 0x00->0xFF   ");
+    // ウェイト
     __delay_ms(1000);
     
     //==========================================================================
-    // oCgPʂ̑MeXg
+    // 複数バイト単位の送信テスト
     //==========================================================================
-    // X^[gRfBV̑M
+    // スタートコンディションの送信
     I2C_u8MstStartSSP2(I2C_ADDR, false);
-    // f[^NA
+    // データクリア
     u8RxData = 0xFF;
     uint8 u8TxData;
     for (u8TxData = 0; u8TxData < 255; u8TxData++) {
         I2C_u8MstTxSSP2(u8TxData);
-        // Mf[^mF
+        // 受信データ確認
         if (u8RxData != u8TxData) {
             break;
         }
     }
     I2C_vMstStopSSP2();
-    // ʕ\
-    ST7032_bSetCursorSSP2(1, 0);
+    // 結果表示
+    ST7032_bSetCursor(&sLcd, 1, 0);
     if (u8TxData == 255) {
-        ST7032_vWriteStringSSP2("Tx 0x00->0xFF OK");
+        ST7032_vWriteString(&sLcd, "Tx 0x00->0xFF OK");
     } else {
-        ST7032_vWriteStringSSP2("Tx 0x00->0xFF NG");
+        ST7032_vWriteString(&sLcd, "Tx 0x00->0xFF NG");
     }
-    // EFCg
+    // ウェイト
     __delay_ms(1000);
 }
 
@@ -465,7 +492,7 @@ static void ssp2_vI2CTest02() {
  *
  * NAME: ssp2_vI2CTest03
  *
- * DESCRIPTION:I2CeXgP[XAoCgPʂ̏݃eXg
+ * DESCRIPTION:I2Cテストケース、複数バイト単位の書き込みテスト
  *
  * PARAMETERS:      Name            RW  Usage
  *
@@ -476,25 +503,25 @@ static void ssp2_vI2CTest02() {
  ******************************************************************************/
 static void ssp2_vI2CTest03() { 
     //==========================================================================
-    // L[ǂݍ݃eXg
+    // キー読み込みテスト
     //==========================================================================
-    // J[\\
-    ST7032_vDispSettingSSP2(true, true, false);
-    // bZ[W
-    ST7032_bSetCursorSSP2(0, 0);
-    ST7032_vWriteStringSSP2("Test:I2C 03     ");
-    ST7032_bSetCursorSSP2(1, 0);
-    ST7032_vWriteStringSSP2("Rx 0x00->0xFF   ");
+    // カーソル表示
+    ST7032_vDispSetting(&sLcd, true, true, false);
+    // メッセージ
+    ST7032_bSetCursor(&sLcd, 0, 0);
+    ST7032_vWriteString(&sLcd, "Test:I2C 03     ");
+    ST7032_bSetCursor(&sLcd, 1, 0);
+    ST7032_vWriteString(&sLcd, "Rx 0x00->0xFF   ");
     
     //==========================================================================
-    // 1oCgPʂ̎MeXg
+    // 1バイト単位の受信テスト
     //==========================================================================
-    // f[^NA
+    // データクリア
     u8RxData = 0x00;
     uint8 u8Data;
     uint8 u8Cnt;
     for (u8Cnt = 0; u8Cnt < 255; u8Cnt++) {
-        // 1oCgǂݍ
+        // 1バイト読み込み
         I2C_u8MstStartSSP2(I2C_ADDR, true);
         u8Data = I2C_u8MstRxSSP2(true);
         I2C_vMstStopSSP2();
@@ -502,19 +529,19 @@ static void ssp2_vI2CTest03() {
             break;
         }
     }
-    // 1oCgǂݍ
+    // 1バイト読み込み
     I2C_u8MstStartSSP2(I2C_ADDR, true);
     u8Data = I2C_u8MstRxSSP2(true);
     I2C_vMstStopSSP2();
     __delay_ms(1000);
-    // ʕ\
-    ST7032_bSetCursorSSP2(1, 14);
+    // 結果表示
+    ST7032_bSetCursor(&sLcd, 1, 14);
     if (u8Data == 255) {
-        ST7032_vWriteStringSSP2("OK");
+        ST7032_vWriteString(&sLcd, "OK");
     } else {
-        ST7032_vWriteStringSSP2("NG");
+        ST7032_vWriteString(&sLcd, "NG");
     }
-    // EFCg
+    // ウェイト
     __delay_ms(1000);
 }
 
@@ -522,7 +549,7 @@ static void ssp2_vI2CTest03() {
  *
  * NAME: ssp2_vI2CTest04
  *
- * DESCRIPTION:I2CeXgP[XAoCgPʂ̏݃eXg
+ * DESCRIPTION:I2Cテストケース、複数バイト単位の書き込みテスト
  *
  * PARAMETERS:      Name            RW  Usage
  *
@@ -533,53 +560,209 @@ static void ssp2_vI2CTest03() {
  ******************************************************************************/
 static void ssp2_vI2CTest04() { 
     //==========================================================================
-    // L[ǂݍ݃eXg
+    // キー読み込みテスト
     //==========================================================================
-    // J[\\
-    ST7032_vDispSettingSSP2(true, true, false);
-    // bZ[W
-    ST7032_bSetCursorSSP2(0, 0);
-    ST7032_vWriteStringSSP2("Test:I2C 04     ");
-    ST7032_bSetCursorSSP2(1, 0);
-    ST7032_vWriteStringSSP2("Rx 0x00->0xFF   ");
+    // カーソル表示
+    ST7032_vDispSetting(&sLcd, true, true, false);
+    // メッセージ
+    ST7032_bSetCursor(&sLcd, 0, 0);
+    ST7032_vWriteString(&sLcd, "Test:I2C 04     ");
+    ST7032_bSetCursor(&sLcd, 1, 0);
+    ST7032_vWriteString(&sLcd, "Rx 0x00->0xFF   ");
     
     //==========================================================================
-    // oCgPʂ̎MeXg
+    // 複数バイト単位の受信テスト
     //==========================================================================
-    // f[^NA
+    // データクリア
     u8RxData = 0x00;
-    // X^[gRfBV
+    // スタートコンディション
     I2C_u8MstStartSSP2(I2C_ADDR, true);
     uint8 u8Data;
     uint8 u8Cnt;
     for (u8Cnt = 0; u8Cnt < 255; u8Cnt++) {
-        // 1oCgǂݍ
+        // 1バイト読み込み
         u8Data = I2C_u8MstRxSSP2(false);
         if (u8Data != u8Cnt) {
             break;
         }
     }
-    // 1oCgǂݍ
+    // 1バイト読み込み
     u8Data = I2C_u8MstRxSSP2(true);
-    // XgbvRfBV
+    // ストップコンディション
     I2C_vMstStopSSP2();
     __delay_ms(1000);
-    // ʕ\
-    ST7032_bSetCursorSSP2(1, 14);
+    // 結果表示
+    ST7032_bSetCursor(&sLcd, 1, 14);
     if (u8Data == 255) {
-        ST7032_vWriteStringSSP2("OK");
+        ST7032_vWriteString(&sLcd, "OK");
     } else {
-        ST7032_vWriteStringSSP2("NG");
+        ST7032_vWriteString(&sLcd, "NG");
     }
-    // EFCg
+    // ウェイト
     __delay_ms(1000);
 }
 
+/*******************************************************************************
+ *
+ * NAME: ssp2_vI2CTest05
+ *
+ * DESCRIPTION:I2Cテストケース、非同期トランザクションの書き込みと読み込み
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void ssp2_vI2CTest05() { 
+    //==========================================================================
+    // 非同期トランザクションテスト
+    //==========================================================================
+    // カーソル表示
+    ST7032_vDispSetting(&sLcd, true, true, false);
+    // メッセージ
+    ST7032_bSetCursor(&sLcd, 0, 0);
+    ST7032_vWriteString(&sLcd, "Test:I2C 05     ");
+    ST7032_bSetCursor(&sLcd, 1, 0);
+    ST7032_vWriteString(&sLcd, "Async Tx/Rx     ");
+    
+    //==========================================================================
+    // 4バイト書き込み後にリスタートして4バイト読み込む
+    //==========================================================================
+    uint8 u8TxData[4] = {0x10, 0x11, 0x12, 0x13};
+    uint8 u8RxBuff[4];
+    tsI2C_MstTrans sTrans;
+    sTrans.u8Address   = I2C_ADDR;
+    sTrans.pu8TxHead   = NULL;
+    sTrans.u8TxHeadLen = 0;
+    sTrans.pu8TxData   = u8TxData;
+    sTrans.u8TxLen     = 4;
+    sTrans.pu8RxData   = u8RxBuff;
+    sTrans.u8RxLen     = 4;
+    sTrans.pvCallback  = NULL;
+    // データクリア
+    u8RxData = 0xFF;
+    // トランザクション登録
+    I2C_bMstSubmitSSP2(&sTrans);
+    // 完了待ちの間にメインループが動作している事を確認する
+    uint16 u16Cnt = 0;
+    while (I2C_bMstBusySSP2()) {
+        u16Cnt++;
+    }
+    // 受信データ確認（最終書き込み値から連番で返信される）
+    uint8 u8Idx;
+    for (u8Idx = 0; u8Idx < 4; u8Idx++) {
+        if (u8RxBuff[u8Idx] != 0x13 + u8Idx) {
+            break;
+        }
+    }
+    // 結果表示
+    ST7032_bSetCursor(&sLcd, 1, 14);
+    if (sTrans.u8Status == I2C_TRANS_COMPLETE && u8Idx == 4 && u16Cnt > 0) {
+        ST7032_vWriteString(&sLcd, "OK");
+    } else {
+        ST7032_vWriteString(&sLcd, "NG");
+    }
+    // ウェイト
+    __delay_ms(1000);
+}
+
+/*******************************************************************************
+ *
+ * NAME: ssp2_vI2CTest06
+ *
+ * DESCRIPTION:I2Cテストケース、完了通知からの非同期トランザクション登録
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 完了通知（割り込み内）で次のトランザクションを登録し、登録順に完了する事と
+ * 完了通知中に全割込みが許可されない事を確認する。
+ ******************************************************************************/
+static void ssp2_vI2CTest06() { 
+    //==========================================================================
+    // 完了通知からの登録テスト
+    //==========================================================================
+    // カーソル表示
+    ST7032_vDispSetting(&sLcd, true, true, false);
+    // メッセージ
+    ST7032_bSetCursor(&sLcd, 0, 0);
+    ST7032_vWriteString(&sLcd, "Test:I2C 06     ");
+    ST7032_bSetCursor(&sLcd, 1, 0);
+    ST7032_vWriteString(&sLcd, "Async Chain     ");
+    
+    //==========================================================================
+    // 1件目の完了通知で2件目を登録する
+    //==========================================================================
+    uint8 u8TxData1[2] = {0x20, 0x21};
+    uint8 u8TxData2[2] = {0x30, 0x31};
+    tsI2C_MstTrans sTrans;
+    sTrans.u8Address   = I2C_ADDR;
+    sTrans.pu8TxHead   = NULL;
+    sTrans.u8TxHeadLen = 0;
+    sTrans.pu8TxData   = u8TxData1;
+    sTrans.u8TxLen     = 2;
+    sTrans.pu8RxData   = NULL;
+    sTrans.u8RxLen     = 0;
+    sTrans.pvCallback  = ssp2_vI2CTest06Done;
+    sChainTrans = sTrans;
+    sChainTrans.pu8TxData = u8TxData2;
+    // データクリア
+    u8DoneCnt = 0;
+    u8DoneOrder[0] = 0x00;
+    u8DoneOrder[1] = 0x00;
+    bDoneGie = true;
+    // トランザクション登録
+    I2C_bMstSubmitSSP2(&sTrans);
+    // 完了待ち（2件目は完了通知中に登録される為、キューは空にならない）
+    I2C_vMstDrainSSP2();
+    // 結果表示
+    ST7032_bSetCursor(&sLcd, 1, 14);
+    if (sTrans.u8Status == I2C_TRANS_COMPLETE && sChainTrans.u8Status == I2C_TRANS_COMPLETE
+            && u8DoneCnt == 2 && u8DoneOrder[0] == 0x20 && u8DoneOrder[1] == 0x30
+            && !bDoneGie) {
+        ST7032_vWriteString(&sLcd, "OK");
+    } else {
+        ST7032_vWriteString(&sLcd, "NG");
+    }
+    // ウェイト
+    __delay_ms(1000);
+}
+
+/*******************************************************************************
+ *
+ * NAME: ssp2_vI2CTest06Done
+ *
+ * DESCRIPTION:I2Cテストケース06の完了通知
+ *
+ * PARAMETERS:      Name            RW  Usage
+ * tsI2C_MstTrans*  psTrans         R   完了したトランザクション
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * 割り込み内で実行される。
+ ******************************************************************************/
+static void ssp2_vI2CTest06Done(tsI2C_MstTrans *psTrans) {
+    if (u8DoneCnt < 2) {
+        u8DoneOrder[u8DoneCnt] = psTrans->pu8TxData[0];
+    }
+    u8DoneCnt++;
+    if (psTrans != &sChainTrans) {
+        // 登録処理の後も全割込みが禁止されたままである事を記録
+        I2C_bMstSubmitSSP2(&sChainTrans);
+        bDoneGie = GIE;
+    }
+}
+
 /*******************************************************************************
  *
  * NAME: ssp2_vLCDTest01
  *
- * DESCRIPTION:I2CeXgP[XAoCgPʂ̏݃eXg
+ * DESCRIPTION:I2Cテストケース、複数バイト単位の書き込みテスト
  *
  * PARAMETERS:      Name            RW  Usage
  *
@@ -590,47 +773,47 @@ static void ssp2_vI2CTest04() {
  ******************************************************************************/
 static void ssp2_vLCDTest01() {
     //==========================================================================
-    // 2sڂɕ`
+    // 2行目に描画
     //==========================================================================
-    // ʃNA
-    ST7032_vClearDispSSP2();
-    // J[\ړ
-    ST7032_vCursorTopSSP2();
-    // s`揈
+    // 画面クリア
+    ST7032_vClearDisp(&sLcd);
+    // カーソル移動
+    ST7032_vCursorTop(&sLcd);
+    // 行描画処理
     uint8 val = (uint8)(rand() % 0xFF);
-    ST7032_vWriteStringSSP2("Test:LCD 01 0x");
-    ST7032_vWriteCharSSP2(hexToChar(val >> 4));
-    ST7032_vWriteCharSSP2(hexToChar(val & 0x0F));
-    // J[\ړ
-    ST7032_bSetCursorSSP2(1, 0);
-    // `
+    ST7032_vWriteString(&sLcd, "Test:LCD 01 0x");
+    ST7032_vWriteChar(&sLcd, hexToChar(val >> 4));
+    ST7032_vWriteChar(&sLcd, hexToChar(val & 0x0F));
+    // カーソル移動
+    ST7032_bSetCursor(&sLcd, 1, 0);
+    // 文字描画
     uint8 u8Idx;
     for (u8Idx = 0; u8Idx <16; u8Idx++) {
-        // s`揈
-        ST7032_vWriteCharSSP2(val);
+        // 行描画処理
+        ST7032_vWriteChar(&sLcd, val);
         val = (val + 1) % 0xFF;
-        // 0.5bԊuŎs
+        // 0.5秒間隔で実行
         __delay_ms(500);
     }
     //==========================================================================
-    // 1sڂɕ`
-    //==========================================================================
-    // ʃNA
-    ST7032_vClearDispSSP2();
-    // J[\ړ
-    ST7032_bSetCursorSSP2(1, 0);
-    // s`揈
-    ST7032_vWriteStringSSP2("Test:LCD 01 0x");
-    ST7032_vWriteCharSSP2(hexToChar(val >> 4));
-    ST7032_vWriteCharSSP2(hexToChar(val & 0x0F));
-    // J[\ړ
-    ST7032_bSetCursorSSP2(0, 0);
-    // `
+    // 1行目に描画
+    //==========================================================================
+    // 画面クリア
+    ST7032_vClearDisp(&sLcd);
+    // カーソル移動
+    ST7032_bSetCursor(&sLcd, 1, 0);
+    // 行描画処理
+    ST7032_vWriteString(&sLcd, "Test:LCD 01 0x");
+    ST7032_vWriteChar(&sLcd, hexToChar(val >> 4));
+    ST7032_vWriteChar(&sLcd, hexToChar(val & 0x0F));
+    // カーソル移動
+    ST7032_bSetCursor(&sLcd, 0, 0);
+    // 文字描画
     for (u8Idx = 0; u8Idx <16; u8Idx++) {
-        // s`揈
-        ST7032_vWriteDataSSP2(&val, 1);
+        // 行描画処理
+        ST7032_vWriteData(&sLcd, &val, 1);
         val = (val + 1) % 0xFF;
-        // 0.5bԊuŎs
+        // 0.5秒間隔で実行
         __delay_ms(500);
     }
 }
@@ -639,7 +822,7 @@ static void ssp2_vLCDTest01() {
  *
  * NAME: ssp2_vLCDTest02
  *
- * DESCRIPTION:LCDeXgP[XAJ[\ړ
+ * DESCRIPTION:LCDテストケース、カーソル移動
  *
  * PARAMETERS:      Name            RW  Usage
  *
@@ -650,129 +833,129 @@ static void ssp2_vLCDTest01() {
  ******************************************************************************/
 static void ssp2_vLCDTest02() {
     //==========================================================================
-    // 2sڂɕ`
-    //==========================================================================
-    // ʃNA
-    ST7032_vClearDispSSP2();
-    // J[\ړ
-    ST7032_bSetCursorSSP2(0, 0);
-    // s`揈
-    ST7032_vWriteStringSSP2("Test:LCD 02 0x0");
-    ST7032_vWriteCharSSP2(hexToChar(ST7032_u8GetCursorRowNoSSP2()));
-    // J[\\
-    ST7032_vDispSettingSSP2(true, true, false);
-    // `
+    // 2行目に描画
+    //==========================================================================
+    // 画面クリア
+    ST7032_vClearDisp(&sLcd);
+    // カーソル移動
+    ST7032_bSetCursor(&sLcd, 0, 0);
+    // 行描画処理
+    ST7032_vWriteString(&sLcd, "Test:LCD 02 0x0");
+    ST7032_vWriteChar(&sLcd, hexToChar(ST7032_u8GetCursorRowNo(&sLcd)));
+    // カーソル表示
+    ST7032_vDispSetting(&sLcd, true, true, false);
+    // 文字描画
     uint8 u8Idx;
     for (u8Idx = 0; u8Idx < 16; u8Idx++) {
-        // J[\ړ
+        // カーソル移動
         if ((u8Idx % 2) == 0) {
-            if (ST7032_bSetCursorSSP2(1, u8Idx) == true) {
-                ST7032_vWriteCharSSP2(hexToChar(ST7032_u8GetCursorColNoSSP2()));
+            if (ST7032_bSetCursor(&sLcd, 1, u8Idx) == true) {
+                ST7032_vWriteChar(&sLcd, hexToChar(ST7032_u8GetCursorColNo(&sLcd)));
             }
         } else {
-            ST7032_bCursorRightSSP2();
+            ST7032_bCursorRight(&sLcd);
         }
-        // 0.5bԊuŎs
+        // 0.5秒間隔で実行
         __delay_ms(500);
     }
     for (u8Idx = 0; u8Idx < 16; u8Idx++) {
-        // J[\ړ
+        // カーソル移動
         if ((u8Idx % 2) == 0) {
-            if (ST7032_bSetCursorSSP2(1, 15 - u8Idx) == true) {
-                ST7032_vWriteCharSSP2(hexToChar(ST7032_u8GetCursorColNoSSP2()));
+            if (ST7032_bSetCursor(&sLcd, 1, 15 - u8Idx) == true) {
+                ST7032_vWriteChar(&sLcd, hexToChar(ST7032_u8GetCursorColNo(&sLcd)));
             }
         } else {
-            ST7032_bCursorLeftSSP2();
+            ST7032_bCursorLeft(&sLcd);
         }
-        // 0.5bԊuŎs
+        // 0.5秒間隔で実行
         __delay_ms(500);
     }
     //==========================================================================
-    // 1sڂɕ`
-    //==========================================================================
-    // ʃNA
-    ST7032_vClearDispSSP2();
-    // J[\ړ
-    ST7032_bSetCursorSSP2(1, 0);
-    // s`揈
-    ST7032_vWriteStringSSP2("Test:LCD 02 0x0");
-    ST7032_vWriteCharSSP2(hexToChar(ST7032_u8GetCursorRowNoSSP2()));
-    // J[\_
-    ST7032_vDispSettingSSP2(true, true, true);
-    // `
+    // 1行目に描画
+    //==========================================================================
+    // 画面クリア
+    ST7032_vClearDisp(&sLcd);
+    // カーソル移動
+    ST7032_bSetCursor(&sLcd, 1, 0);
+    // 行描画処理
+    ST7032_vWriteString(&sLcd, "Test:LCD 02 0x0");
+    ST7032_vWriteChar(&sLcd, hexToChar(ST7032_u8GetCursorRowNo(&sLcd)));
+    // カーソル点滅
+    ST7032_vDispSetting(&sLcd, true, true, true);
+    // 文字描画
     for (u8Idx = 0; u8Idx <16; u8Idx++) {
-        // J[\ړ
+        // カーソル移動
         if ((u8Idx % 2) == 0) {
-            ST7032_bSetCursorSSP2(0, u8Idx);
-            ST7032_vWriteCharSSP2(hexToChar(ST7032_u8GetCursorColNoSSP2()));
+            ST7032_bSetCursor(&sLcd, 0, u8Idx);
+            ST7032_vWriteChar(&sLcd, hexToChar(ST7032_u8GetCursorColNo(&sLcd)));
         } else {
-            ST7032_bCursorRightSSP2();
+            ST7032_bCursorRight(&sLcd);
         }
-        // 0.5bԊuŎs
+        // 0.5秒間隔で実行
         __delay_ms(500);
     }
     for (u8Idx = 0; u8Idx <16; u8Idx++) {
-        // J[\ړ
+        // カーソル移動
         if ((u8Idx % 2) == 0) {
-            ST7032_bSetCursorSSP2(0, 15 - u8Idx);
-            ST7032_vWriteCharSSP2(hexToChar(ST7032_u8GetCursorColNoSSP2()));
+            ST7032_bSetCursor(&sLcd, 0, 15 - u8Idx);
+            ST7032_vWriteChar(&sLcd, hexToChar(ST7032_u8GetCursorColNo(&sLcd)));
         } else {
-            ST7032_bCursorLeftSSP2();
+            ST7032_bCursorLeft(&sLcd);
         }
-        // 0.5bԊuŎs
+        // 0.5秒間隔で実行
         __delay_ms(500);
     }
     //==========================================================================
-    // 2sڂɕ`
-    //==========================================================================
-    // ʃNA
-    ST7032_vClearDispSSP2();
-    // J[\ړ
-    ST7032_bSetCursorSSP2(0, 0);
-    // s`揈
-    ST7032_vWriteStringSSP2("Test:LCD 02 ");
-    // J[\\
-    ST7032_vDispSettingSSP2(true, true, false);
-    // J[\ړ
-    ST7032_bSetCursorSSP2(1, 38);
-    if (ST7032_bCursorRightSSP2() == true) {
-        ST7032_bSetCursorSSP2(0, 12);
-        ST7032_vWriteCharSSP2('A');
+    // 2行目に描画
+    //==========================================================================
+    // 画面クリア
+    ST7032_vClearDisp(&sLcd);
+    // カーソル移動
+    ST7032_bSetCursor(&sLcd, 0, 0);
+    // 行描画処理
+    ST7032_vWriteString(&sLcd, "Test:LCD 02 ");
+    // カーソル表示
+    ST7032_vDispSetting(&sLcd, true, true, false);
+    // カーソル移動
+    ST7032_bSetCursor(&sLcd, 1, 38);
+    if (ST7032_bCursorRight(&sLcd) == true) {
+        ST7032_bSetCursor(&sLcd, 0, 12);
+        ST7032_vWriteChar(&sLcd, 'A');
     }
-    // 1bԊuŎs
+    // 1秒間隔で実行
     __delay_ms(1000);
-    ST7032_bSetCursorSSP2(1, 39);
-    if (ST7032_bCursorRightSSP2() == false) {
-        ST7032_bSetCursorSSP2(0, 13);
-        ST7032_vWriteCharSSP2('B');
+    ST7032_bSetCursor(&sLcd, 1, 39);
+    if (ST7032_bCursorRight(&sLcd) == false) {
+        ST7032_bSetCursor(&sLcd, 0, 13);
+        ST7032_vWriteChar(&sLcd, 'B');
     }
-    // 1bԊuŎs
+    // 1秒間隔で実行
     __delay_ms(1000);
-    ST7032_bSetCursorSSP2(0, 1);
-    if (ST7032_bCursorLeftSSP2() == true) {
-        ST7032_bSetCursorSSP2(0, 14);
-        ST7032_vWriteCharSSP2('C');
+    ST7032_bSetCursor(&sLcd, 0, 1);
+    if (ST7032_bCursorLeft(&sLcd) == true) {
+        ST7032_bSetCursor(&sLcd, 0, 14);
+        ST7032_vWriteChar(&sLcd, 'C');
     }
-    // 1bԊuŎs
+    // 1秒間隔で実行
     __delay_ms(1000);
-    ST7032_bSetCursorSSP2(0, 0);
-    if (ST7032_bCursorLeftSSP2() == false) {
-        ST7032_bSetCursorSSP2(0, 15);
-        ST7032_vWriteCharSSP2('D');
+    ST7032_bSetCursor(&sLcd, 0, 0);
+    if (ST7032_bCursorLeft(&sLcd) == false) {
+        ST7032_bSetCursor(&sLcd, 0, 15);
+        ST7032_vWriteChar(&sLcd, 'D');
     }
-    // 1bԊuŎs
+    // 1秒間隔で実行
     __delay_ms(1000);
-    if (ST7032_bSetCursorSSP2(1, 39) == true) {
-        ST7032_bSetCursorSSP2(1, 0);
-        ST7032_vWriteCharSSP2('E');
+    if (ST7032_bSetCursor(&sLcd, 1, 39) == true) {
+        ST7032_bSetCursor(&sLcd, 1, 0);
+        ST7032_vWriteChar(&sLcd, 'E');
     }
-    // 1bԊuŎs
+    // 1秒間隔で実行
     __delay_ms(1000);
-    if (ST7032_bSetCursorSSP2(1, 40) == false) {
-        ST7032_bSetCursorSSP2(1, 1);
-        ST7032_vWriteCharSSP2('F');
+    if (ST7032_bSetCursor(&sLcd, 1, 40) == false) {
+        ST7032_bSetCursor(&sLcd, 1, 1);
+        ST7032_vWriteChar(&sLcd, 'F');
     }
-    // 1bԊuŎs
+    // 1秒間隔で実行
     __delay_ms(1000);
 }
 
@@ -780,7 +963,7 @@ static void ssp2_vLCDTest02() {
  *
  * NAME: ssp2_vLCDTest03
  *
- * DESCRIPTION:LCDeXgP[XACGRAM
+ * DESCRIPTION:LCDテストケース、CGRAM
  *
  * PARAMETERS:      Name            RW  Usage
  *
@@ -791,10 +974,10 @@ static void ssp2_vLCDTest02() {
  ******************************************************************************/
 static void ssp2_vLCDTest03() {
     //==========================================================================
-    // CGRAMւ̏
+    // CGRAMへの書き込み
     //==========================================================================
     uint8 u8BitMap[] = {0x11, 0x0A, 0x04, 0x15, 0x15, 0x04, 0x0A, 0x11};
-    ST7032_vWriteCGRAMSSP2(0x00, u8BitMap);
+    ST7032_vWriteCGRAM(&sLcd, 0x00, u8BitMap);
     u8BitMap[0] = 0x04;
     u8BitMap[1] = 0x0A;
     u8BitMap[2] = 0x11;
@@ -803,7 +986,7 @@ static void ssp2_vLCDTest03() {
     u8BitMap[5] = 0x0A;
     u8BitMap[6] = 0x11;
     u8BitMap[7] = 0x0E;
-    ST7032_vWriteCGRAMSSP2(0x01, u8BitMap);
+    ST7032_vWriteCGRAM(&sLcd, 0x01, u8BitMap);
     u8BitMap[0] = 0x11;
     u8BitMap[1] = 0x15;
     u8BitMap[2] = 0x15;
@@ -812,7 +995,7 @@ static void ssp2_vLCDTest03() {
     u8BitMap[5] = 0x0A;
     u8BitMap[6] = 0x0A;
     u8BitMap[7] = 0x04;
-    ST7032_vWriteCGRAMSSP2(0x02, u8BitMap);
+    ST7032_vWriteCGRAM(&sLcd, 0x02, u8BitMap);
     u8BitMap[0] = 0x1F;
     u8BitMap[1] = 0x00;
     u8BitMap[2] = 0x0E;
@@ -821,7 +1004,7 @@ static void ssp2_vLCDTest03() {
     u8BitMap[5] = 0x00;
     u8BitMap[6] = 0x15;
     u8BitMap[7] = 0x15;
-    ST7032_vWriteCGRAMSSP2(0x03, u8BitMap);
+    ST7032_vWriteCGRAM(&sLcd, 0x03, u8BitMap);
     u8BitMap[0] = 0x1F;
     u8BitMap[1] = 0x11;
     u8BitMap[2] = 0x15;
@@ -830,7 +1013,7 @@ static void ssp2_vLCDTest03() {
     u8BitMap[5] = 0x15;
     u8BitMap[6] = 0x15;
     u8BitMap[7] = 0x15;
-    ST7032_vWriteCGRAMSSP2(0x04, u8BitMap);
+    ST7032_vWriteCGRAM(&sLcd, 0x04, u8BitMap);
     u8BitMap[0] = 0x15;
     u8BitMap[1] = 0x15;
     u8BitMap[2] = 0x0E;
@@ -839,7 +1022,7 @@ static void ssp2_vLCDTest03() {
     u8BitMap[5] = 0x15;
     u8BitMap[6] = 0x0A;
     u8BitMap[7] = 0x15;
-    ST7032_vWriteCGRAMSSP2(0x05, u8BitMap);
+    ST7032_vWriteCGRAM(&sLcd, 0x05, u8BitMap);
     u8BitMap[0] = 0x1F;
     u8BitMap[1] = 0x11;
     u8BitMap[2] = 0x15;
@@ -848,7 +1031,7 @@ static void ssp2_vLCDTest03() {
     u8BitMap[5] = 0x1F;
     u8BitMap[6] = 0x00;
     u8BitMap[7] = 0x1F;
-    ST7032_vWriteCGRAMSSP2(0x06, u8BitMap);
+    ST7032_vWriteCGRAM(&sLcd, 0x06, u8BitMap);
     u8BitMap[0] = 0x1F;
     u8BitMap[1] = 0x11;
     u8BitMap[2] = 0x10;
@@ -857,45 +1040,45 @@ static void ssp2_vLCDTest03() {
     u8BitMap[5] = 0x15;
     u8BitMap[6] = 0x11;
     u8BitMap[7] = 0x1F;
-    ST7032_vWriteCGRAMSSP2(0x07, u8BitMap);
+    ST7032_vWriteCGRAM(&sLcd, 0x07, u8BitMap);
     
     //==========================================================================
-    // 2sڂɕ`
-    //==========================================================================
-    // ʃNA
-    ST7032_vClearDispSSP2();
-    // J[\ړ
-    ST7032_bSetCursorSSP2(0, 0);
-    // s`揈
-    ST7032_vWriteStringSSP2("Test:LCD 03     ");
-    // J[\\
-    ST7032_vDispSettingSSP2(true, true, false);
-    // J[\ړ
-    ST7032_bSetCursorSSP2(1, 0);
+    // 2行目に描画
+    //==========================================================================
+    // 画面クリア
+    ST7032_vClearDisp(&sLcd);
+    // カーソル移動
+    ST7032_bSetCursor(&sLcd, 0, 0);
+    // 行描画処理
+    ST7032_vWriteString(&sLcd, "Test:LCD 03     ");
+    // カーソル表示
+    ST7032_vDispSetting(&sLcd, true, true, false);
+    // カーソル移動
+    ST7032_bSetCursor(&sLcd, 1, 0);
     uint8 u8Idx;
     for (u8Idx = 0; u8Idx < 16; u8Idx++) {
-        // `揈
-        ST7032_vWriteCharSSP2(u8Idx);
-        // 0.5bԊuŎs
+        // 描画処理
+        ST7032_vWriteChar(&sLcd, u8Idx);
+        // 0.5秒間隔で実行
         __delay_ms(500);
     }
     //==========================================================================
-    // 1sڂɕ`
-    //==========================================================================
-    // ʃNA
-    ST7032_vClearDispSSP2();
-    // J[\ړ
-    ST7032_bSetCursorSSP2(1, 0);
-    // s`揈
-    ST7032_vWriteStringSSP2("Test:LCD 03     ");
-    // J[\\
-    ST7032_vDispSettingSSP2(true, true, false);
-    // J[\ړ
-    ST7032_bSetCursorSSP2(0, 0);
+    // 1行目に描画
+    //==========================================================================
+    // 画面クリア
+    ST7032_vClearDisp(&sLcd);
+    // カーソル移動
+    ST7032_bSetCursor(&sLcd, 1, 0);
+    // 行描画処理
+    ST7032_vWriteString(&sLcd, "Test:LCD 03     ");
+    // カーソル表示
+    ST7032_vDispSetting(&sLcd, true, true, false);
+    // カーソル移動
+    ST7032_bSetCursor(&sLcd, 0, 0);
     for (u8Idx = 0; u8Idx < 16; u8Idx++) {
-        // `揈
-        ST7032_vWriteCharSSP2(u8Idx);
-        // 0.5bԊuŎs
+        // 描画処理
+        ST7032_vWriteChar(&sLcd, u8Idx);
+        // 0.5秒間隔で実行
         __delay_ms(500);
     }
 }
@@ -904,7 +1087,7 @@ static void ssp2_vLCDTest03() {
  *
  * NAME: ssp2_vLCDTest04
  *
- * DESCRIPTION:LCDeXgP[XAACR
+ * DESCRIPTION:LCDテストケース、アイコン
  *
  * PARAMETERS:      Name            RW  Usage
  *
@@ -915,44 +1098,90 @@ static void ssp2_vLCDTest03() {
  ******************************************************************************/
 static void ssp2_vLCDTest04() {
     //==========================================================================
-    // ACR`
-    //==========================================================================
-    // ʃNA
-    ST7032_vClearDispSSP2();
-    // ACRNA
-    ST7032_vClearIconSSP2();
-    // J[\\
-    ST7032_vDispSettingSSP2(true, true, false);
-    // J[\ړ
-    ST7032_bSetCursorSSP2(0, 0);
-    // s`揈
-    ST7032_vWriteStringSSP2("Test:LCD 04 0:00");
-    // ACR
+    // アイコンを描画
+    //==========================================================================
+    // 画面クリア
+    ST7032_vClearDisp(&sLcd);
+    // アイコンクリア
+    ST7032_vClearIcon(&sLcd);
+    // カーソル表示
+    ST7032_vDispSetting(&sLcd, true, true, false);
+    // カーソル移動
+    ST7032_bSetCursor(&sLcd, 0, 0);
+    // 行描画処理
+    ST7032_vWriteString(&sLcd, "Test:LCD 04 0:00");
+    // アイコン
     uint8 u8Addr;
     uint8 u8SVal;
     for (u8Addr = 0; u8Addr < 16; u8Addr++) {
-        // AhX
-        ST7032_bSetCursorSSP2(0, 12);
-        ST7032_vWriteCharSSP2(hexToChar(u8Addr));
-        // l
+        // アドレス
+        ST7032_bSetCursor(&sLcd, 0, 12);
+        ST7032_vWriteChar(&sLcd, hexToChar(u8Addr));
+        // 値
         for (u8SVal = 0; u8SVal < 32; u8SVal++) {
-            // lo
-            ST7032_bSetCursorSSP2(0, 14);
-            ST7032_vWriteCharSSP2(hexToChar(u8SVal >> 4));
-            ST7032_vWriteCharSSP2(hexToChar(u8SVal & 0x0F));
-            // ACR`
-            ST7032_vWriteIconSSP2(u8Addr, u8SVal);
-            // 0.05bԊuŎs
+            // 値出力
+            ST7032_bSetCursor(&sLcd, 0, 14);
+            ST7032_vWriteChar(&sLcd, hexToChar(u8SVal >> 4));
+            ST7032_vWriteChar(&sLcd, hexToChar(u8SVal & 0x0F));
+            // アイコン描画
+            ST7032_vWriteIcon(&sLcd, u8Addr, u8SVal);
+            // 0.05秒間隔で実行
             __delay_ms(50);
         }
     }
 }
 
+/*******************************************************************************
+ *
+ * NAME: ssp2_vLCDTest05
+ *
+ * DESCRIPTION:LCDテストケース、シャドウ表示データ
+ *
+ * PARAMETERS:      Name            RW  Usage
+ *
+ * RETURNS:
+ *
+ * NOTES:
+ * None.
+ ******************************************************************************/
+static void ssp2_vLCDTest05() {
+    //==========================================================================
+    // シャドウ表示データ経由で描画
+    //==========================================================================
+    // 画面クリア
+    ST7032_vClearDisp(&sLcd);
+    // カーソル表示
+    ST7032_vDispSetting(&sLcd, true, true, false);
+    // カーソル移動
+    ST7032_bSetCursor(&sLcd, 1, 15);
+    // 行描画処理
+    ST7032_bSetShadow(&sLcd, 0, 0, (uint8*)"Test:LCD 05     ", 16);
+    ST7032_vFlush(&sLcd);
+    // 変更されたセルのみ描画（カーソルは１行目末尾に戻る）
+    uint8 u8Msg[] = "Cnt:00 Cnt:00   ";
+    uint8 u8Cnt;
+    for (u8Cnt = 0; u8Cnt < 100; u8Cnt++) {
+        u8Msg[4]  = '0' + (u8Cnt / 10);
+        u8Msg[5]  = '0' + (u8Cnt % 10);
+        u8Msg[11] = u8Msg[5];
+        ST7032_bSetShadow(&sLcd, 1, 0, u8Msg, 16);
+        ST7032_vFlush(&sLcd);
+        // 0.1秒間隔で実行
+        __delay_ms(100);
+    }
+    // 直接書き込みとの整合性（変更無しの為、送信されない）
+    ST7032_bSetCursor(&sLcd, 1, 0);
+    ST7032_vWriteString(&sLcd, "Cnt:99");
+    ST7032_bSetShadow(&sLcd, 1, 0, (uint8*)"Cnt:99", 6);
+    ST7032_vFlush(&sLcd);
+    __delay_ms(1000);
+}
+
 /*******************************************************************************
  *
  * NAME: ssp2_vKeypadTest01
  *
- * DESCRIPTION:L[pbheXgP[X
+ * DESCRIPTION:キーパッドテストケース
  *
  * PARAMETERS:      Name            RW  Usage
  *
@@ -963,29 +1192,29 @@ static void ssp2_vLCDTest04() {
  ******************************************************************************/
 static void ssp2_vKeypadTest01() {
     //==========================================================================
-    // L[ǂݍ݃eXg
+    // キー読み込みテスト
     //==========================================================================
-    // J[\\
-    ST7032_vDispSettingSSP2(true, true, false);
-    // bZ[W
-    ST7032_bSetCursorSSP2(0, 0);
-    ST7032_vWriteStringSSP2("Test:Keypad 01  ");
-    ST7032_bSetCursorSSP2(1, 0);
-    ST7032_vWriteStringSSP2("None   :        ");
+    // カーソル表示
+    ST7032_vDispSetting(&sLcd, true, true, false);
+    // メッセージ
+    ST7032_bSetCursor(&sLcd, 0, 0);
+    ST7032_vWriteString(&sLcd, "Test:Keypad 01  ");
+    ST7032_bSetCursor(&sLcd, 1, 0);
+    ST7032_vWriteString(&sLcd, "None   :        ");
     //==========================================================================
-    // ̓[hF͖
+    // 入力モード：入力無効
     //==========================================================================
     eInputMode = INPUT_MODE_NONE;
     KEYPAD_vClearBuffer();
-    // 10bԓ͖
+    // 10秒間入力無効
     uint8 u8Idx;
     for (u8Idx = 0; u8Idx < 100; u8Idx++) {
         if (KEYPAD_u8ReadBuffer() == 0xFF) {
-            ST7032_bSetCursorSSP2(1, 5);
-            ST7032_vWriteCharSSP2(HEX_LIST[10 - (u8Idx / 10)]);
+            ST7032_bSetCursor(&sLcd, 1, 5);
+            ST7032_vWriteChar(&sLcd, HEX_LIST[10 - (u8Idx / 10)]);
         } else {
-            ST7032_bSetCursorSSP2(1, 0);
-            ST7032_vWriteStringSSP2("None:Error      ");
+            ST7032_bSetCursor(&sLcd, 1, 0);
+            ST7032_vWriteString(&sLcd, "None:Error      ");
         }
         __delay_ms(100);
     }
@@ -995,7 +1224,7 @@ static void ssp2_vKeypadTest01() {
  *
  * NAME: ssp2_vKeypadTest02
  *
- * DESCRIPTION:L[pbheXgP[X
+ * DESCRIPTION:キーパッドテストケース
  *
  * PARAMETERS:      Name            RW  Usage
  *
@@ -1006,30 +1235,30 @@ static void ssp2_vKeypadTest01() {
  ******************************************************************************/
 static void ssp2_vKeypadTest02() {
     //==========================================================================
-    // L[ǂݍ݃eXg
+    // キー読み込みテスト
     //==========================================================================
-    // J[\\
-    ST7032_vDispSettingSSP2(true, true, false);
-    // bZ[W
-    ST7032_bSetCursorSSP2(0, 0);
-    ST7032_vWriteStringSSP2("Test:Keypad 02  ");
-    ST7032_bSetCursorSSP2(1, 0);
-    ST7032_vWriteStringSSP2("Current:Input 1 ");
+    // カーソル表示
+    ST7032_vDispSetting(&sLcd, true, true, false);
+    // メッセージ
+    ST7032_bSetCursor(&sLcd, 0, 0);
+    ST7032_vWriteString(&sLcd, "Test:Keypad 02  ");
+    ST7032_bSetCursor(&sLcd, 1, 0);
+    ST7032_vWriteString(&sLcd, "Current:Input 1 ");
     //==========================================================================
-    // ̓[hFݒl[h
+    // 入力モード：現在値モード
     //==========================================================================
-    // ݒl[h
+    // 現在値モード
     eInputMode = INPUT_MODE_CURRENT;
     KEYPAD_vClearBuffer();
     u8KeyValue = 0xFF;
-    // L[͔
+    // キー入力判定
     uint8 u8Idx;
     for (u8Idx = 0; u8Idx < 16; u8Idx++) {
         while (u8KeyValue != u8Idx) {
             __delay_ms(10);
         }
-        ST7032_bSetCursorSSP2(1, 14);
-        ST7032_vWriteCharSSP2(KEY_LIST[u8Idx + 1]);
+        ST7032_bSetCursor(&sLcd, 1, 14);
+        ST7032_vWriteChar(&sLcd, KEY_LIST[u8Idx + 1]);
     }
 }
 
@@ -1037,7 +1266,7 @@ static void ssp2_vKeypadTest02() {
  *
  * NAME: ssp2_vKeypadTest03
  *
- * DESCRIPTION:L[pbheXgP[X
+ * DESCRIPTION:キーパッドテストケース
  *
  * PARAMETERS:      Name            RW  Usage
  *
@@ -1048,30 +1277,30 @@ static void ssp2_vKeypadTest02() {
  ******************************************************************************/
 static void ssp2_vKeypadTest03() {
     //==========================================================================
-    // L[ǂݍ݃eXg
+    // キー読み込みテスト
     //==========================================================================
-    // J[\\
-    ST7032_vDispSettingSSP2(true, true, false);
-    // bZ[W
-    ST7032_bSetCursorSSP2(0, 0);
-    ST7032_vWriteStringSSP2("Test:Keypad 03  ");
-    ST7032_bSetCursorSSP2(1, 0);
-    ST7032_vWriteStringSSP2("Final  :Input 1 ");
+    // カーソル表示
+    ST7032_vDispSetting(&sLcd, true, true, false);
+    // メッセージ
+    ST7032_bSetCursor(&sLcd, 0, 0);
+    ST7032_vWriteString(&sLcd, "Test:Keypad 03  ");
+    ST7032_bSetCursor(&sLcd, 1, 0);
+    ST7032_vWriteString(&sLcd, "Final  :Input 1 ");
     //==========================================================================
-    // ̓[hFŏIl[h
+    // 入力モード：最終値モード
     //==========================================================================
-    // ݒl[h
+    // 現在値モード
     eInputMode = INPUT_MODE_FINAL;
     KEYPAD_vClearBuffer();
     u8KeyValue = 0xFF;
-    // L[͔
+    // キー入力判定
     uint8 u8Idx;
     for (u8Idx = 0; u8Idx < 16; u8Idx++) {
         while (KEYPAD_u8ReadFinal() != u8Idx) {
             __delay_ms(2000);
         }
-        ST7032_bSetCursorSSP2(1, 14);
-        ST7032_vWriteCharSSP2(KEY_LIST[u8Idx + 1]);
+        ST7032_bSetCursor(&sLcd, 1, 14);
+        ST7032_vWriteChar(&sLcd, KEY_LIST[u8Idx + 1]);
     }
 }
 
@@ -1079,7 +1308,7 @@ static void ssp2_vKeypadTest03() {
  *
  * NAME: ssp2_vKeypadTest04
  *
- * DESCRIPTION:L[pbheXgP[X
+ * DESCRIPTION:キーパッドテストケース
  *
  * PARAMETERS:      Name            RW  Usage
  *
@@ -1090,30 +1319,30 @@ static void ssp2_vKeypadTest03() {
  ******************************************************************************/
 static void ssp2_vKeypadTest04() {
     //==========================================================================
-    // L[ǂݍ݃eXg
+    // キー読み込みテスト
     //==========================================================================
-    // J[\\
-    ST7032_vDispSettingSSP2(true, true, false);
-    // bZ[W
-    ST7032_bSetCursorSSP2(0, 0);
-    ST7032_vWriteStringSSP2("Test:Keypad 04  ");
-    ST7032_bSetCursorSSP2(1, 0);
-    ST7032_vWriteStringSSP2("Buffer :Input 1 ");
+    // カーソル表示
+    ST7032_vDispSetting(&sLcd, true, true, false);
+    // メッセージ
+    ST7032_bSetCursor(&sLcd, 0, 0);
+    ST7032_vWriteString(&sLcd, "Test:Keypad 04  ");
+    ST7032_bSetCursor(&sLcd, 1, 0);
+    ST7032_vWriteString(&sLcd, "Buffer :Input 1 ");
     //==========================================================================
-    // ̓[hFobt@O[h
+    // 入力モード：バッファリングモード
     //==========================================================================
-    // ݒl[h
+    // 現在値モード
     eInputMode = INPUT_MODE_BUFFERING;
     KEYPAD_vClearBuffer();
     u8KeyValue = 0xFF;
-    // L[͔
+    // キー入力判定
     uint8 u8Idx;
     for (u8Idx = 0; u8Idx < 16; u8Idx++) {
         while (KEYPAD_u8ReadBuffer() != u8Idx) {
             __delay_ms(2000);
         }
-        ST7032_bSetCursorSSP2(1, 14);
-        ST7032_vWriteCharSSP2(KEY_LIST[u8Idx + 1]);
+        ST7032_bSetCursor(&sLcd, 1, 14);
+        ST7032_vWriteChar(&sLcd, KEY_LIST[u8Idx + 1]);
     }
 }
 
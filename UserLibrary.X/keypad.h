@@ -34,33 +34,76 @@ extern "C" {
 /******************************************************************************/
 // KeyPad Setting
 #ifndef KEYPAD_ROW_SIZE
-#define KEYPAD_ROW_SIZE        (4)      // sTCY
+#define KEYPAD_ROW_SIZE        (4)      // 行サイズ
 #endif
 
 #ifndef KEYPAD_COL_SIZE
-#define KEYPAD_COL_SIZE        (4)      // TCY
+#define KEYPAD_COL_SIZE        (4)      // 列サイズ
+#endif
+
+// キー状態は16bitのビットマップ（キー番号 = 行 * KEYPAD_COL_SIZE + 列）
+#if (KEYPAD_ROW_SIZE * KEYPAD_COL_SIZE) > 16
+#error "KEYPAD_ROW_SIZE * KEYPAD_COL_SIZE must be 16 or less"
 #endif
 
 #ifndef KEYPAD_BUFF_SIZE
-#define KEYPAD_BUFF_SIZE       (4)      // obt@TCY
+#define KEYPAD_BUFF_SIZE       (4)      // バッファサイズ
 #endif
 
+// チャタリング判定回数の上限（キー毎の判定回数は4bitで保持）
+#define KEYPAD_DEBOUNCE_MAX    (15)
+
+// ポート番号（ピンマップのID_PORTxから判定）
+#define KEYPAD_PORT_A          (0)
+#define KEYPAD_PORT_B          (1)
+#define KEYPAD_PORT_C          (2)
+#define KEYPAD_PORT_CNT        (3)      // ポート数
+#define KEYPAD_PORT_NONE       (3)      // 対象外のピン
+
 /******************************************************************************/
 /***        Type Definitions                                                ***/
 /******************************************************************************/
 /**
- * KEYPADp̃Xe[^X
+ * キーイベント種別
+ */
+enum KEYPAD_Event {
+    KEYPAD_EVT_NONE    = 0x00,  // イベント無し
+    KEYPAD_EVT_PRESS   = 0x01,  // 押下
+    KEYPAD_EVT_RELEASE = 0x02,  // 解放
+    KEYPAD_EVT_REPEAT  = 0x03,  // 押しっぱなしによるリピート
+    KEYPAD_EVT_LONG    = 0x04   // 長押し（最初のリピートの時点）
+};
+
+/**
+ * KEYPAD用のステータス情報
  */
 typedef struct {
-    uint8 u8CheckCnt;                       // 1b̃`FbN
-    uint16 u16PinCols[KEYPAD_COL_SIZE];     // s}bvz
-    uint16 u16PinRows[KEYPAD_ROW_SIZE];     // ss}bvz
-    uint8 u8BeforeKeyNo;                    // OL[ԍ
-    uint16 u16KeyChkCnt;                    // L[Ao
-    uint8 u8KeyBuffer[KEYPAD_BUFF_SIZE];    // L[obt@
-    uint8 u8BuffSize;                       // L[obt@TCY
-    uint8 u8BuffBeginIdx;                   // L[obt@CfbNX
-    uint8 u8BuffEndIdx;                     // L[obt@CfbNX
+    uint8 u8CheckCnt;                       // 1秒当たりのチェック回数
+    uint16 u16PinCols[KEYPAD_COL_SIZE];     // 列ピンマップ配列
+    uint16 u16PinRows[KEYPAD_ROW_SIZE];     // 行ピンマップ配列
+    uint8 u8SenseMask[KEYPAD_PORT_CNT];     // ポート毎の列ピンのマスク
+    uint8 u8ScanRow;                        // 走査中（駆動中）の行
+    uint16 u16ScanMap;                      // 走査中のキー状態ビットマップ
+    uint16 u16KeyState;                     // 走査済みのキー状態ビットマップ（16キーまで）
+    bool bGhost;                            // ゴースト検出中
+    uint8 u8Debounce;                       // チャタリング判定回数（実行時設定、KEYPAD_DEBOUNCE_MAXまで）
+    uint8 u8RepeatDelay;                    // 長押しまでの回数（実行時設定）
+    uint8 u8RepeatRate;                     // 最短のリピート間隔（実行時設定）
+    uint8 u8RepeatAccel;                    // リピート毎の間隔の短縮回数（実行時設定）
+    uint8 u8KeyCnt[(KEYPAD_ROW_SIZE * KEYPAD_COL_SIZE + 1) / 2]; // キー毎の判定回数（4bit、奇数キーは上位）
+    uint16 u16Pressed;                      // 確定済みのキー状態ビットマップ
+    uint16 u16Pending;                      // 判定中のキーのビットマップ
+    uint8 u8RepeatIdx;                      // リピート対象のキー（0xFF:無し）
+    uint8 u8RepeatCnt;                      // リピート間隔の経過回数
+    uint8 u8RepeatIntvl;                    // 現在のリピート間隔
+    bool bRepeating;                        // 長押し通知済み
+    uint8 u8KeyBuffer[KEYPAD_BUFF_SIZE];    // キーバッファ
+    uint8 u8BuffSize;                       // キーバッファサイズ
+    uint8 u8BuffBeginIdx;                   // キーバッファインデックス
+    uint8 u8BuffEndIdx;                     // キーバッファインデックス
+    uint8 u8EventKeyNo;                     // 未読イベントのキー番号
+    uint8 u8EventType;                      // 未読イベントの種別
+    void (*pvCallback)(uint8 u8KeyNo, uint8 u8Type); // キーイベントの通知先
 } tsKEYPAD_status;
 
 /******************************************************************************/
@@ -78,20 +121,34 @@ typedef struct {
 /******************************************************************************/
 /***        Exported Functions                                              ***/
 /******************************************************************************/
-/**  */
+/** 初期化処理 */
 extern void KEYPAD_vInit(tsKEYPAD_status *spStatus);
-/** obt@XV */
+/** バッファ更新 */
 extern bool KEYPAD_bUpdateBuffer();
-/** obt@TCY擾 */
+/** 走査済みキー番号のバッファリング */
+extern bool KEYPAD_bWriteBuffer(uint8 u8KeyNo);
+/** バッファサイズ取得 */
 extern uint8 KEYPAD_u8BufferSize();
-/** obt@NA */
+/** バッファクリア */
 extern void KEYPAD_vClearBuffer();
-/** ݃L[l̓ǂݍ */
+/** 現在キー値の読み込み */
 extern uint8 KEYPAD_u8Read();
-/** obt@̃L[ǂݍ */
+/** １行分の走査と現在キー値の読み込み */
+extern uint8 KEYPAD_u8ScanStep();
+/** キー状態ビットマップの読み込み */
+extern uint16 KEYPAD_u16ReadState();
+/** 確定済みのキー状態ビットマップの読み込み */
+extern uint16 KEYPAD_u16ReadPressed();
+/** ゴーストの検出状態 */
+extern bool KEYPAD_bGhost();
+/** バッファからのキー読み込み */
 extern uint8 KEYPAD_u8ReadBuffer();
-/** ŏIobt@L[ǂݍ */
+/** 最終バッファキー読み込み */
 extern uint8 KEYPAD_u8ReadFinal();
+/** キーイベントの読み込み */
+extern uint8 KEYPAD_u8ReadEvent(uint8 *pu8KeyNo);
+/** キーイベント通知先の登録 */
+extern void KEYPAD_vSetCallback(void (*pvCallback)(uint8 u8KeyNo, uint8 u8Type));
 
 /******************************************************************************/
 /***        Local Functions                                                 ***/
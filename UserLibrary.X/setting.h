@@ -32,8 +32,10 @@ extern "C" {
 /******************************************************************************/
 /***        Macro Definitions                                               ***/
 /******************************************************************************/
-// gݒ
-#define _XTAL_FREQ  16000000    // delaypɕKv(NbN16MHzw)
+// 周波数設定
+#define _XTAL_FREQ  16000000    // delay用に必要(クロック16MHzを指定)
+// LCDシャドウ表示データの桁数（16桁x2行のLCD）
+#define ST7032_SHADOW_COL_SIZE  (16)
 
 /******************************************************************************/
 /***        Type Definitions                                                ***/